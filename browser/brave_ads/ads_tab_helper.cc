@@ -77,35 +77,76 @@ void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
-
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
-                     weak_factory_.GetWeakPtr()));
+  // Serializing the page and sending it to the ads service is expensive for
+  // heavy pages, so only the content needed for the visited URL is extracted
+  ads_service_->ShouldLoadPageContent(
+      redirect_chain_,
+      base::BindOnce(&AdsTabHelper::OnShouldLoadPageContent,
+                     weak_factory_.GetWeakPtr(),
+                     render_frame_host->GetGlobalFrameRoutingId(),
+                     redirect_chain_));
 }
 
-void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
-  DCHECK(ads_service_ && ads_service_->IsEnabled());
+void AdsTabHelper::OnShouldLoadPageContent(
+    const content::GlobalFrameRoutingId& render_frame_host_id,
+    const std::vector<GURL>& redirect_chain,
+    const bool should_load_html,
+    const bool should_load_text) {
+  if (!IsAdsEnabled()) {
+    return;
+  }
+
+  content::RenderFrameHost* render_frame_host =
+      content::RenderFrameHost::FromID(render_frame_host_id);
+  if (!render_frame_host) {
+    return;
+  }
+
+  if (should_load_html) {
+    dom_distiller::RunIsolatedJavaScript(
+        render_frame_host, "new XMLSerializer().serializeToString(document)",
+        base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
+                       weak_factory_.GetWeakPtr(), redirect_chain));
+  } else {
+    ads_service_->OnHtmlLoaded(tab_id_, redirect_chain, "");
+  }
+
+  if (should_load_text) {
+    dom_distiller::RunIsolatedJavaScript(
+        render_frame_host, "document?.body?.innerText",
+        base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
+                       weak_factory_.GetWeakPtr(), redirect_chain));
+  } else {
+    ads_service_->OnTextLoaded(tab_id_, redirect_chain, "");
+  }
+}
+
+void AdsTabHelper::OnJavaScriptHtmlResult(
+    const std::vector<GURL>& redirect_chain,
+    base::Value value) {
+  if (!IsAdsEnabled()) {
+    return;
+  }
 
   DCHECK(value.is_string());
   std::string html;
   value.GetAsString(&html);
 
-  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, html);
+  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain, html);
 }
 
-void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
-  DCHECK(ads_service_ && ads_service_->IsEnabled());
+void AdsTabHelper::OnJavaScriptTextResult(
+    const std::vector<GURL>& redirect_chain,
+    base::Value value) {
+  if (!IsAdsEnabled()) {
+    return;
+  }
 
   DCHECK(value.is_string());
   std::string text;
   value.GetAsString(&text);
 
-  ads_service_->OnTextLoaded(tab_id_, redirect_chain_, text);
+  ads_service_->OnTextLoaded(tab_id_, redirect_chain, text);
 }
 
 void AdsTabHelper::DidFinishNavigation(
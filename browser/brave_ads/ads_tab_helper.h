@@ -15,6 +15,7 @@
 #include "base/memory/weak_ptr.h"
 #include "build/build_config.h"
 #include "components/sessions/core/session_id.h"
+#include "content/public/browser/global_routing_id.h"
 #include "content/public/browser/media_player_id.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
@@ -61,9 +62,17 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
 
-  void OnJavaScriptHtmlResult(base::Value value);
+  void OnShouldLoadPageContent(
+      const content::GlobalFrameRoutingId& render_frame_host_id,
+      const std::vector<GURL>& redirect_chain,
+      const bool should_load_html,
+      const bool should_load_text);
 
-  void OnJavaScriptTextResult(base::Value value);
+  void OnJavaScriptHtmlResult(const std::vector<GURL>& redirect_chain,
+                              base::Value value);
+
+  void OnJavaScriptTextResult(const std::vector<GURL>& redirect_chain,
+                              base::Value value);
 
   // content::WebContentsObserver overrides
   void DidFinishNavigation(
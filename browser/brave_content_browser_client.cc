@@ -27,6 +27,7 @@
 #include "brave/common/webui_url_constants.h"
 #include "brave/components/binance/browser/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/browser/buildflags/buildflags.h"
+#include "brave/components/brave_search/browser/backup_results_fetcher.h"
 #include "brave/components/brave_search/browser/brave_search_host.h"
 #include "brave/components/brave_search/common/brave_search.mojom.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -225,8 +226,8 @@ void BindBraveSearchHost(
   content::BrowserContext* context = render_process_host->GetBrowserContext();
   mojo::MakeSelfOwnedReceiver(
       std::make_unique<brave_search::BraveSearchHost>(
-          content::BrowserContext::GetDefaultStoragePartition(context)
-              ->GetURLLoaderFactoryForBrowserProcess()),
+          brave_search::BackupResultsFetcher::GetForBrowserContext(context)
+              ->AsWeakPtr()),
       std::move(receiver));
 }
 }  // namespace
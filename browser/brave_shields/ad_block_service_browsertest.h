@@ -8,13 +8,15 @@
 
 #include <string>
 
+#include "base/auto_reset.h"
+#include "base/time/time.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 
 class HostContentSettingsMap;
 
 class AdBlockServiceTest : public extensions::ExtensionBrowserTest {
  public:
-  AdBlockServiceTest() {}
+  AdBlockServiceTest();
 
   // ExtensionBrowserTest overrides
   void SetUpOnMainThread() override;
@@ -38,6 +40,9 @@ class AdBlockServiceTest : public extensions::ExtensionBrowserTest {
   void WaitForAdBlockServiceThreads();
   void WaitForBraveExtensionShieldsDataReady();
   void ShieldsDown(const GURL& url);
+
+ private:
+  base::AutoReset<base::TimeDelta> blocked_counts_flush_delay_override_;
 };
 
 #endif  // BRAVE_BROWSER_BRAVE_SHIELDS_AD_BLOCK_SERVICE_BROWSERTEST_H_
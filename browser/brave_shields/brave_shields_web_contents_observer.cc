@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_perf_predictor/browser/buildflags.h"
@@ -50,6 +51,16 @@ using content::WebContents;
 
 namespace {
 
+base::TimeDelta g_blocked_counts_flush_delay = base::TimeDelta::FromSeconds(1);
+
+// Profile wide counters of the resources blocked by shields.
+base::flat_map<std::string, std::string> GetBlockedCountPrefNames() {
+  return {{brave_shields::kAds, kAdsBlocked},
+          {brave_shields::kHTTPUpgradableResources, kHttpsUpgrades},
+          {brave_shields::kJavaScript, kJavascriptBlocked},
+          {brave_shields::kFingerprintingV2, kFingerprintingBlocked}};
+}
+
 // Content Settings are only sent to the main frame currently. Chrome may fix
 // this at some point, but for now we do this as a work-around. You can verify
 // if this is fixed by running the following test: npm run test --
@@ -87,6 +98,7 @@ BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
     : WebContentsObserver(web_contents),
+      blocked_resource_counter_(GetBlockedCountPrefNames()),
       brave_shields_receivers_(web_contents, this) {}
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(RenderFrameHost* rfh) {
@@ -116,14 +128,45 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
   }
 }
 
-bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
-    const std::string& subresource) {
-  return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
+// static
+base::AutoReset<base::TimeDelta>
+BraveShieldsWebContentsObserver::SetBlockedCountsFlushDelayForTesting(
+    base::TimeDelta delay) {
+  return base::AutoReset<base::TimeDelta>(&g_blocked_counts_flush_delay,
+                                          delay);
 }
 
-void BraveShieldsWebContentsObserver::AddBlockedSubresource(
+void BraveShieldsWebContentsObserver::OnBlockedSubresource(
+    const std::string& block_type,
     const std::string& subresource) {
-  blocked_url_paths_.insert(subresource);
+  // Repeated blocks of the same subresource on a page are already accounted
+  // for, and the shields panel ignores them too.
+  if (!blocked_resource_counter_.Add(block_type, subresource)) {
+    return;
+  }
+
+  DispatchBlockedEventForWebContents(block_type, subresource, web_contents());
+
+  if (!blocked_resource_counter_.has_pending_counts()) {
+    return;
+  }
+
+  blocked_resource_counter_.ScheduleFlush(GetBlockedCountsPrefs(),
+                                          g_blocked_counts_flush_delay);
+}
+
+PrefService* BraveShieldsWebContentsObserver::GetBlockedCountsPrefs() {
+  return Profile::FromBrowserContext(web_contents()->GetBrowserContext())
+      ->GetOriginalProfile()
+      ->GetPrefs();
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedCounts() {
+  if (!blocked_resource_counter_.has_pending_counts()) {
+    return;
+  }
+
+  blocked_resource_counter_.Flush(GetBlockedCountsPrefs());
 }
 
 // static
@@ -136,30 +179,14 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
   auto subresource = request_url.spec();
   WebContents* web_contents =
       WebContents::FromFrameTreeNodeId(frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
-
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer && !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs =
-          Profile::FromBrowserContext(web_contents->GetBrowserContext())
-              ->GetOriginalProfile()
-              ->GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-                         prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-                         prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+  BraveShieldsWebContentsObserver* observer =
+      web_contents
+          ? BraveShieldsWebContentsObserver::FromWebContents(web_contents)
+          : nullptr;
+  if (observer) {
+    observer->OnBlockedSubresource(block_type, subresource);
+  } else {
+    DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
   }
 #if BUILDFLAG(ENABLE_BRAVE_PERF_PREDICTOR)
   brave_perf_predictor::PerfPredictorTabHelper::DispatchBlockedEvent(
@@ -223,15 +250,16 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    FlushBlockedCounts();
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
-      blocked_url_paths_.clear();
+      blocked_resource_counter_.ClearSeenSubresources();
     } else if (reload_type == content::ReloadType::NORMAL) {
       // For normal reloads (or loads to the current URL, internally converted
       // into reloads i.e see NavigationControllerImpl::NavigateWithoutEntry),
       // we only reset the counter for blocked URLs, not the one for scripts.
-      blocked_url_paths_.clear();
+      blocked_resource_counter_.ClearSeenSubresources();
     }
   }
 
@@ -242,6 +270,10 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   }
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedCounts();
+}
+
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
     const std::vector<std::string>& origins,
     WebContents* contents) {
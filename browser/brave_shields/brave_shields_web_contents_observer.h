@@ -7,13 +7,16 @@
 #define BRAVE_BROWSER_BRAVE_SHIELDS_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
 #include <map>
-#include <set>
 #include <string>
 #include <vector>
 
+#include "base/auto_reset.h"
+#include "base/compiler_specific.h"
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "brave/components/brave_shields/browser/blocked_resource_counter.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_receiver_set.h"
@@ -24,6 +27,7 @@ class WebContents;
 }
 
 class PrefRegistrySimple;
+class PrefService;
 
 namespace brave_shields {
 
@@ -44,10 +48,13 @@ class BraveShieldsWebContentsObserver
                                    int frame_tree_node_id,
                                    const std::string& block_type);
   static GURL GetTabURLFromRenderFrameInfo(int render_frame_tree_node_id);
+  // Blocked counts are written to prefs at most once per |delay| until the
+  // returned value goes out of scope. A zero delay writes them as soon as they
+  // change.
+  static base::AutoReset<base::TimeDelta> SetBlockedCountsFlushDelayForTesting(
+      base::TimeDelta delay) WARN_UNUSED_RESULT;
   void AllowScriptsOnce(const std::vector<std::string>& origins,
                         content::WebContents* web_contents);
-  bool IsBlockedSubresource(const std::string& subresource);
-  void AddBlockedSubresource(const std::string& subresource);
 
  protected:
   // content::WebContentsObserver overrides.
@@ -57,6 +64,7 @@ class BraveShieldsWebContentsObserver
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // brave_shields::mojom::BraveShieldsHost.
   void OnJavaScriptBlocked(const std::u16string& details) override;
@@ -73,10 +81,15 @@ class BraveShieldsWebContentsObserver
   mojo::AssociatedRemote<brave_shields::mojom::BraveShields>&
   GetBraveShieldsRemote(content::RenderFrameHost* rfh);
 
+  void OnBlockedSubresource(const std::string& block_type,
+                            const std::string& subresource);
+  PrefService* GetBlockedCountsPrefs();
+  void FlushBlockedCounts();
+
   std::vector<std::string> allowed_script_origins_;
-  // We keep a set of the current page's blocked URLs in case the page
+  // We keep track of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
-  std::set<std::string> blocked_url_paths_;
+  BlockedResourceCounter blocked_resource_counter_;
 
   content::WebContentsFrameReceiverSet<brave_shields::mojom::BraveShieldsHost>
       brave_shields_receivers_;
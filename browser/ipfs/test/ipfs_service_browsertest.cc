@@ -3,10 +3,21 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/base64.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_restrictions.h"
 #include "base/test/mock_callback.h"
 #include "base/test/scoped_feature_list.h"
 #include "brave/browser/brave_browser_process.h"
@@ -28,6 +39,7 @@
 #include "components/network_session_configurator/common/network_switches.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/test/browser_test.h"
+#include "net/base/url_util.h"
 #include "net/dns/mock_host_resolver.h"
 #include "net/test/embedded_test_server/http_request.h"
 #include "net/test/embedded_test_server/http_response.h"
@@ -36,6 +48,17 @@
 namespace {
 const char kTestLinkImportPath[] = "/link.png";
 const char kUnavailableLinkImportPath[] = "/unavailable.png";
+const char kChunkedFolderName[] = "chunked-folder";
+
+// Returns the values of all "arg" parameters of an ipfs api request.
+std::vector<std::string> GetArgs(const GURL& url) {
+  std::vector<std::string> args;
+  for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
+    if (it.GetKey() == "arg")
+      args.push_back(it.GetUnescapedValue());
+  }
+  return args;
+}
 
 std::string GetFileNameForText(const std::string& text,
                                const std::string& host) {
@@ -308,6 +331,117 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return nullptr;
   }
 
+  // Mimics the ipfs api for chunked folder imports, every file part of
+  // an add request gets its own NDJSON line in the response, followed by
+  // a line for the folder itself. Runs on the test server thread.
+  std::unique_ptr<net::test_server::HttpResponse> HandleChunkedImportRequests(
+      const net::test_server::HttpRequest& request) {
+    const GURL gurl = request.GetURL();
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    http_response->set_code(net::HTTP_OK);
+    http_response->set_content_type("application/json");
+    base::AutoLock lock(chunked_requests_lock_);
+    if (gurl.path_piece() == kImportAddPath) {
+      ++chunked_add_requests_;
+      const std::string kFilenameMarker = "filename=\"";
+      std::string response;
+      size_t pos = request.content.find(kFilenameMarker);
+      while (pos != std::string::npos) {
+        pos += kFilenameMarker.size();
+        size_t end = request.content.find('"', pos);
+        std::string name = request.content.substr(pos, end - pos);
+        response += base::StrCat({R"({"Name":")", name,
+                                  R"(","Hash":"QmFile","Size":"10"})", "\n"});
+        pos = request.content.find(kFilenameMarker, end);
+      }
+      response += base::StrCat(
+          {R"({"Name":")", kChunkedFolderName, R"(","Hash":"QmDir"})", "\n"});
+      http_response->set_content(response);
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportMakeDirectoryPath) {
+      std::vector<std::string> args = GetArgs(gurl);
+      EXPECT_EQ(args.size(), 1u);
+      EXPECT_TRUE(chunked_copied_files_.empty());
+      if (!args.empty())
+        chunked_created_directories_.push_back(args.front());
+      http_response->set_content("{}");
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportCopyPath) {
+      std::vector<std::string> args = GetArgs(gurl);
+      EXPECT_EQ(args.size(), 2u);
+      if (args.size() == 2u) {
+        EXPECT_EQ(args[0], "/ipfs/QmFile");
+        chunked_copied_files_.push_back(args[1]);
+      }
+      http_response->set_content("{}");
+      return http_response;
+    }
+    if (gurl.path_piece() == kAPIPublishNameEndpoint) {
+      http_response->set_content("{}");
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportStatPath) {
+      http_response->set_content(
+          R"({"Hash":"QmFolder","Size":0,"Type":"directory"})");
+      return http_response;
+    }
+    return nullptr;
+  }
+
+  void OnChunkedImportProgress(const std::string& filename,
+                               size_t imported_files,
+                               size_t total_files) {
+    EXPECT_FALSE(filename.empty());
+    EXPECT_LE(imported_files, total_files);
+    EXPECT_EQ(imported_files, ++progress_notifications_);
+    EXPECT_TRUE(progress_files_.insert(filename).second);
+    total_files_ = total_files;
+  }
+
+  void OnChunkedImportCompleted(const ipfs::ImportedData& data) {
+    EXPECT_EQ(data.hash, "QmFolder");
+    EXPECT_EQ(data.filename, kChunkedFolderName);
+    ASSERT_FALSE(data.directory.empty());
+    ASSERT_EQ(data.state, ipfs::IPFS_IMPORT_SUCCESS);
+    EXPECT_GT(progress_notifications_, 0u);
+    EXPECT_EQ(progress_notifications_, total_files_);
+    chunked_import_directory_ = data.directory;
+    if (wait_for_request_) {
+      wait_for_request_->Quit();
+    }
+  }
+
+  // Creates |kChunkedFolderName| with more files than fit in a single chunk,
+  // spread over nested and empty directories. Returns the relative names of
+  // the files and directories, the folder itself included.
+  base::FilePath CreateChunkedFolder(std::vector<std::string>* files,
+                                     std::vector<std::string>* directories) {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    EXPECT_TRUE(chunked_temp_dir_.CreateUniqueTempDir());
+    const base::FilePath folder =
+        chunked_temp_dir_.GetPath().AppendASCII(kChunkedFolderName);
+    const std::vector<std::pair<std::string, int>> kTree = {
+        {kChunkedFolderName, 50},
+        {std::string(kChunkedFolderName) + "/a", 40},
+        {std::string(kChunkedFolderName) + "/a/b", 30},
+        {std::string(kChunkedFolderName) + "/c", 0}};
+    for (const auto& directory : kTree) {
+      const base::FilePath path =
+          chunked_temp_dir_.GetPath().AppendASCII(directory.first);
+      EXPECT_TRUE(base::CreateDirectory(path));
+      directories->push_back(directory.first);
+      for (int i = 0; i < directory.second; ++i) {
+        const std::string name = "file" + base::NumberToString(i) + ".txt";
+        EXPECT_TRUE(base::WriteFile(path.AppendASCII(name), name));
+        files->push_back(directory.first + "/" + name);
+      }
+    }
+    return folder;
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleGetNodeInfo(
       const net::test_server::HttpRequest& request) {
     const GURL gurl = request.GetURL();
@@ -597,7 +731,18 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
 
   FakeIpfsService* fake_ipfs_service() { return fake_service_.get(); }
 
+ protected:
+  std::set<std::string> progress_files_;
+  std::string chunked_import_directory_;
+  base::Lock chunked_requests_lock_;
+  size_t chunked_add_requests_ = 0;
+  std::vector<std::string> chunked_created_directories_;
+  std::vector<std::string> chunked_copied_files_;
+
  private:
+  size_t progress_notifications_ = 0;
+  size_t total_files_ = 0;
+  base::ScopedTempDir chunked_temp_dir_;
   std::unique_ptr<FakeIpfsService> fake_service_;
   std::unique_ptr<base::RunLoop> wait_for_request_;
   std::unique_ptr<net::EmbeddedTestServer> test_server_;
@@ -1061,6 +1206,60 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportDirectoryToIpfsSuccess) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest,
+                       ImportDirectoryInChunksSuccess) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleChunkedImportRequests,
+      base::Unretained(this)));
+  std::vector<std::string> files;
+  std::vector<std::string> directories;
+  auto test_path = CreateChunkedFolder(&files, &directories);
+  ipfs_service()->ImportDirectoryToIpfsInChunks(
+      test_path, std::string(),
+      base::BindRepeating(&IpfsServiceBrowserTest::OnChunkedImportProgress,
+                          base::Unretained(this)),
+      base::BindOnce(&IpfsServiceBrowserTest::OnChunkedImportCompleted,
+                     base::Unretained(this)));
+  WaitForRequest();
+
+  // Every file is reported once from the add responses, the folder lines
+  // are not counted.
+  EXPECT_EQ(progress_files_, std::set<std::string>(files.begin(), files.end()));
+
+  std::vector<std::string> expected_directories;
+  for (const auto& directory : directories)
+    expected_directories.push_back(chunked_import_directory_ + directory);
+  std::vector<std::string> expected_copies;
+  for (const auto& file : files)
+    expected_copies.push_back(chunked_import_directory_ + file);
+
+  base::AutoLock lock(chunked_requests_lock_);
+  // 120 files are added in chunks of at most 64 files.
+  EXPECT_EQ(chunked_add_requests_, 2u);
+  std::sort(chunked_created_directories_.begin(),
+            chunked_created_directories_.end());
+  std::sort(expected_directories.begin(), expected_directories.end());
+  EXPECT_EQ(chunked_created_directories_, expected_directories);
+  std::sort(chunked_copied_files_.begin(), chunked_copied_files_.end());
+  std::sort(expected_copies.begin(), expected_copies.end());
+  EXPECT_EQ(chunked_copied_files_, expected_copies);
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportDirectoryInChunksFail) {
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleImportRequestsFail,
+                          base::Unretained(this)));
+  auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+  auto test_path = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(folder));
+  ipfs_service()->ImportDirectoryToIpfsInChunks(
+      test_path, std::string(), ImportProgressCallback(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedFail,
+                     base::Unretained(this), IPFS_IMPORT_ERROR_ADD_FAILED,
+                     "autoplay-whitelist-data"));
+  WaitForRequest();
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportAndPinDirectorySuccess) {
   std::string expected_response =
       R"({"Name":"autoplay-whitelist-data", "Size":"567857", "Hash": "QmYbK4SLa"})";
@@ -21,20 +21,24 @@ base::Optional<std::string> GetCspDirectivesOnTaskRunner(
     std::shared_ptr<BraveRequestInfo> ctx,
     base::Optional<std::string> original_csp) {
   std::string source_host;
+  bool is_third_party;
   if (ctx->initiator_url.is_valid() && !ctx->initiator_url.host().empty()) {
     source_host = ctx->initiator_url.host();
+    is_third_party = !ctx->IsRequestSameSiteWithInitiator();
   } else if (ctx->request_url.is_valid()) {
     // Top-level document requests do not have a valid initiator URL, and
     // requests from special schemes like file:// do not have host parts, so we
     // use the request URL as the initiator.
     source_host = ctx->request_url.host();
+    // A host is always same-site with itself, unless it is empty.
+    is_third_party = source_host.empty();
   } else {
     return base::nullopt;
   }
 
   base::Optional<std::string> csp_directives =
       g_brave_browser_process->ad_block_service()->GetCspDirectives(
-          ctx->request_url, ctx->resource_type, source_host);
+          ctx->request_url, ctx->resource_type, source_host, is_third_party);
 
   brave_shields::MergeCspDirectiveInto(original_csp, &csp_directives);
   return csp_directives;
@@ -164,14 +164,17 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
   const std::string source_host = ctx->initiator_url.host();
 
   GURL url_to_check;
+  bool is_third_party;
   if (canonical_url.has_value()) {
     url_to_check = *canonical_url;
+    is_third_party = !ctx->IsInitiatorSameSiteWith(url_to_check);
   } else {
     url_to_check = ctx->request_url;
+    is_third_party = !ctx->IsRequestSameSiteWithInitiator();
   }
 
   g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-      url_to_check, ctx->resource_type, source_host,
+      url_to_check, ctx->resource_type, source_host, is_third_party,
       &previous_result.did_match_rule, &previous_result.did_match_exception,
       &previous_result.did_match_important, &ctx->mock_data_url);
 
@@ -3,10 +3,11 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <memory>
 #include <string>
 
-#include "brave/browser/net/url_context.h"
 #include "brave/browser/net/brave_stp_util.h"
+#include "brave/browser/net/url_context.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
 #include "content/public/test/browser_task_environment.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
@@ -40,6 +41,21 @@ const char kRawHeaders[] =
     "report-uri=\"https://www.pkp.org/hpkp-report\"\n"
     "X-XSS-Protection: 0";
 
+const char kRawHeadersMixedCase[] =
+    "HTTP/1.0 200 OK\n"
+    "strict-transport-security: max-age=31557600\n"
+    "Accept-Language: *\n"
+    "expect-CT: max-age=86400, enforce "
+    "report-uri=\"https://foo.example/report\"\n"
+    "public-key-pins:"
+    "pin-sha256=\"cUPcTAZWKaASuYWhhBAkE3h2+soZS7sWs=\""
+    "max-age=5184000; includeSubDomains\n"
+    "PUBLIC-KEY-PINS-REPORT-ONLY:"
+    "pin-sha256=\"cUPcTAZWKaASuYWhhBAkE3h2+soZS7sWs=\""
+    "max-age=5184000; includeSubDomains"
+    "report-uri=\"https://www.pkp.org/hpkp-report\"\n"
+    "X-XSS-Protection: 0";
+
 class BraveNetworkDelegateBaseTest : public testing::Test {
  public:
   BraveNetworkDelegateBaseTest()
@@ -55,56 +71,71 @@ class BraveNetworkDelegateBaseTest : public testing::Test {
 
 TEST_F(BraveNetworkDelegateBaseTest, RemoveTrackableSecurityHeaders) {
   net::TestDelegate test_delegate;
-  GURL request_url(kThirdPartyDomain);
-  GURL tab_url(kFirstPartyDomain);
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(GURL(kThirdPartyDomain));
+  ctx->tab_origin = GURL(kFirstPartyDomain);
 
   scoped_refptr<HttpResponseHeaders> headers(
       new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
+  scoped_refptr<HttpResponseHeaders> override_headers;
 
-  RemoveTrackableSecurityHeadersForThirdParty(request_url,
-                                              url::Origin::Create(tab_url),
-                                              nullptr, &headers);
+  RemoveTrackableSecurityHeadersForThirdParty(ctx.get(), headers.get(),
+                                              &override_headers);
+  ASSERT_TRUE(override_headers);
   for (auto header : *TrackableSecurityHeaders()) {
-    EXPECT_FALSE(headers->HasHeader(header.as_string()));
+    EXPECT_FALSE(override_headers->HasHeader(header.as_string()));
   }
-  EXPECT_TRUE(headers->HasHeader(kAcceptLanguageHeader));
-  EXPECT_TRUE(headers->HasHeader(kXSSProtectionHeader));
+  EXPECT_TRUE(override_headers->HasHeader(kAcceptLanguageHeader));
+  EXPECT_TRUE(override_headers->HasHeader(kXSSProtectionHeader));
 }
 
 TEST_F(BraveNetworkDelegateBaseTest, RemoveTrackableSecurityHeadersMixedCase) {
   net::TestDelegate test_delegate;
-  GURL request_url(kThirdPartyDomain);
-  GURL tab_url(kFirstPartyDomain);
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(GURL(kThirdPartyDomain));
+  ctx->tab_origin = GURL(kFirstPartyDomain);
 
-  scoped_refptr<HttpResponseHeaders> headers(
-      new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
+  scoped_refptr<HttpResponseHeaders> headers(new HttpResponseHeaders(
+      net::HttpUtil::AssembleRawHeaders(kRawHeadersMixedCase)));
+  scoped_refptr<HttpResponseHeaders> override_headers;
 
-  RemoveTrackableSecurityHeadersForThirdParty(request_url,
-                                              url::Origin::Create(tab_url),
-                                              nullptr, &headers);
+  RemoveTrackableSecurityHeadersForThirdParty(ctx.get(), headers.get(),
+                                              &override_headers);
+  ASSERT_TRUE(override_headers);
   for (auto header : *TrackableSecurityHeaders()) {
-    EXPECT_FALSE(headers->HasHeader(header.as_string()));
+    EXPECT_FALSE(override_headers->HasHeader(header.as_string()));
   }
-  EXPECT_TRUE(headers->HasHeader(kAcceptLanguageHeader));
-  EXPECT_TRUE(headers->HasHeader(kXSSProtectionHeader));
+  EXPECT_TRUE(override_headers->HasHeader(kAcceptLanguageHeader));
+  EXPECT_TRUE(override_headers->HasHeader(kXSSProtectionHeader));
 }
 
 TEST_F(BraveNetworkDelegateBaseTest, RetainTrackableSecurityHeaders) {
   net::TestDelegate test_delegate;
-  GURL request_url(kFirstPartyDomain);
-  GURL tab_url(kFirstPartyDomain);
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(
+      GURL("http://sub.firstparty.com/"));
+  ctx->tab_origin = GURL(kFirstPartyDomain);
 
   scoped_refptr<HttpResponseHeaders> headers(
       new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
+  scoped_refptr<HttpResponseHeaders> override_headers;
 
-  RemoveTrackableSecurityHeadersForThirdParty(request_url,
-                                              url::Origin::Create(tab_url),
-                                              nullptr, &headers);
+  RemoveTrackableSecurityHeadersForThirdParty(ctx.get(), headers.get(),
+                                              &override_headers);
+  EXPECT_FALSE(override_headers);
   for (auto header : *TrackableSecurityHeaders()) {
     EXPECT_TRUE(headers->HasHeader(header.as_string()));
   }
-  EXPECT_TRUE(headers->HasHeader(kAcceptLanguageHeader));
-  EXPECT_TRUE(headers->HasHeader(kXSSProtectionHeader));
+}
+
+TEST_F(BraveNetworkDelegateBaseTest, RetainTrackableSecurityHeadersWithoutTab) {
+  net::TestDelegate test_delegate;
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(GURL(kThirdPartyDomain));
+
+  scoped_refptr<HttpResponseHeaders> headers(
+      new HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(kRawHeaders)));
+  scoped_refptr<HttpResponseHeaders> override_headers;
+
+  RemoveTrackableSecurityHeadersForThirdParty(ctx.get(), headers.get(),
+                                              &override_headers);
+  EXPECT_FALSE(override_headers);
 }
 
 }  // namespace
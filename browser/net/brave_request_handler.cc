@@ -210,11 +210,8 @@ int BraveRequestHandler::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
-  if (!ctx->tab_origin.is_empty()) {
-    brave::RemoveTrackableSecurityHeadersForThirdParty(
-        ctx->request_url, url::Origin::Create(ctx->tab_origin),
-        original_response_headers, override_response_headers);
-  }
+  brave::RemoveTrackableSecurityHeadersForThirdParty(
+      ctx.get(), original_response_headers, override_response_headers);
 
   if (headers_received_callbacks_.empty() &&
       !ctx->request_url.SchemeIs(content::kChromeUIScheme)) {
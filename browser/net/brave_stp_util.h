@@ -9,15 +9,22 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "net/http/http_response_headers.h"
-#include "url/gurl.h"
-#include "url/origin.h"
 
 namespace brave {
 
+struct BraveRequestInfo;
+
 base::flat_set<base::StringPiece>* TrackableSecurityHeaders();
 
+void RemoveTrackableSecurityHeaders(
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers);
+
+// Removes the trackable security headers from responses to requests made by
+// a tab for a different site. Responses that are not for a tab are left as
+// they are.
 void RemoveTrackableSecurityHeadersForThirdParty(
-    const GURL& request_url, const url::Origin& top_frame_origin,
+    BraveRequestInfo* ctx,
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers);
 
@@ -17,6 +17,7 @@
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 #if BUILDFLAG(IPFS_ENABLED)
 #include "brave/components/ipfs/ipfs_constants.h"
@@ -55,6 +56,67 @@ BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
 
 BraveRequestInfo::~BraveRequestInfo() = default;
 
+const std::string& BraveRequestInfo::CachedDomain::Get(const GURL& url) {
+  if (!computed_ || url.host_piece() != host_) {
+    computed_ = true;
+    host_ = url.host();
+    domain_ = net::registry_controlled_domains::GetDomainAndRegistry(
+        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  }
+  return domain_;
+}
+
+// static
+bool BraveRequestInfo::SameDomainOrHost(const GURL& url1,
+                                        CachedDomain* domain1,
+                                        const GURL& url2,
+                                        CachedDomain* domain2) {
+  // Mirrors net::registry_controlled_domains::SameDomainOrHost().
+  const base::StringPiece host1 = url1.host_piece();
+  const base::StringPiece host2 = url2.host_piece();
+  if (host1.empty() || host2.empty()) {
+    return false;
+  }
+  if (host1 == host2) {
+    return true;
+  }
+  const std::string& registrable_domain1 = domain1->Get(url1);
+  return !registrable_domain1.empty() &&
+         registrable_domain1 == domain2->Get(url2);
+}
+
+const std::string& BraveRequestInfo::GetRequestDomain() {
+  return request_domain_.Get(request_url);
+}
+
+const std::string& BraveRequestInfo::GetInitiatorDomain() {
+  return initiator_domain_.Get(initiator_url);
+}
+
+const std::string& BraveRequestInfo::GetTabOriginDomain() {
+  return tab_origin_domain_.Get(tab_origin);
+}
+
+bool BraveRequestInfo::IsRequestSameSiteWithInitiator() {
+  return SameDomainOrHost(request_url, &request_domain_, initiator_url,
+                          &initiator_domain_);
+}
+
+bool BraveRequestInfo::IsRequestSameSiteWithTabOrigin() {
+  return SameDomainOrHost(request_url, &request_domain_, tab_origin,
+                          &tab_origin_domain_);
+}
+
+bool BraveRequestInfo::IsRequestSameSiteWith(const GURL& url) {
+  CachedDomain domain;
+  return SameDomainOrHost(request_url, &request_domain_, url, &domain);
+}
+
+bool BraveRequestInfo::IsInitiatorSameSiteWith(const GURL& url) {
+  CachedDomain domain;
+  return SameDomainOrHost(initiator_url, &initiator_domain_, url, &domain);
+}
+
 // static
 std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
     const network::ResourceRequest& request,
@@ -101,6 +101,21 @@ struct BraveRequestInfo {
 
   bool ShouldMockRequest() const { return !mock_data_url.empty(); }
 
+  // Registrable domains (eTLD+1, private registries included) of
+  // |request_url|, |initiator_url| and |tab_origin|. Most delegate helpers
+  // compare the same URLs, so each domain is looked up once and cached until
+  // the host changes. Empty if the host has no registrable domain.
+  const std::string& GetRequestDomain();
+  const std::string& GetInitiatorDomain();
+  const std::string& GetTabOriginDomain();
+
+  // Same as net::registry_controlled_domains::SameDomainOrHost() with
+  // INCLUDE_PRIVATE_REGISTRIES, but reusing the cached domains above.
+  bool IsRequestSameSiteWithInitiator();
+  bool IsRequestSameSiteWithTabOrigin();
+  bool IsRequestSameSiteWith(const GURL& url);
+  bool IsInitiatorSameSiteWith(const GURL& url);
+
   net::NetworkIsolationKey network_isolation_key = net::NetworkIsolationKey();
 
   // Default to invalid type for resource_type, so delegate helpers
@@ -126,8 +141,27 @@ struct BraveRequestInfo {
   // We should also remove the one below.
   friend class ::BraveRequestHandler;
 
+  class CachedDomain {
+   public:
+    const std::string& Get(const GURL& url);
+
+   private:
+    bool computed_ = false;
+    std::string host_;
+    std::string domain_;
+  };
+
+  static bool SameDomainOrHost(const GURL& url1,
+                               CachedDomain* domain1,
+                               const GURL& url2,
+                               CachedDomain* domain2);
+
   GURL* new_url = nullptr;
 
+  CachedDomain request_domain_;
+  CachedDomain initiator_domain_;
+  CachedDomain tab_origin_domain_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
@@ -0,0 +1,77 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_context.h"
+
+#include <memory>
+#include <vector>
+
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+bool SameDomainOrHost(const GURL& url1, const GURL& url2) {
+  return net::registry_controlled_domains::SameDomainOrHost(
+      url1, url2, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+}
+
+const std::vector<GURL>& GetTestURLs() {
+  static const std::vector<GURL> urls(
+      {GURL("https://brave.com/"), GURL("https://www.brave.com/path?q=1"),
+       GURL("http://a.b.brave.com:8080/"), GURL("https://example.com/"),
+       GURL("https://example.co.uk/"), GURL("https://foo.example.co.uk/"),
+       GURL("https://co.uk/"), GURL("https://user.github.io/"),
+       GURL("https://other.github.io/"), GURL("https://github.io/"),
+       GURL("http://127.0.0.1/"), GURL("http://127.0.0.1:8080/"),
+       GURL("http://[::1]/"), GURL("http://localhost/"),
+       GURL("http://intranet/"), GURL("file:///tmp/file.html"),
+       GURL("data:text/html,foo"), GURL()});
+  return urls;
+}
+
+}  // namespace
+
+namespace brave {
+
+TEST(BraveRequestInfoTest, SameSiteMatchesRegistryControlledDomains) {
+  for (const GURL& request_url : GetTestURLs()) {
+    for (const GURL& other_url : GetTestURLs()) {
+      auto ctx = std::make_shared<BraveRequestInfo>(request_url);
+      ctx->initiator_url = other_url;
+      ctx->tab_origin = other_url.GetOrigin();
+
+      const bool expected = SameDomainOrHost(request_url, other_url);
+      EXPECT_EQ(expected, ctx->IsRequestSameSiteWithInitiator())
+          << request_url << " " << other_url;
+      EXPECT_EQ(SameDomainOrHost(request_url, ctx->tab_origin),
+                ctx->IsRequestSameSiteWithTabOrigin())
+          << request_url << " " << other_url;
+      EXPECT_EQ(expected, ctx->IsRequestSameSiteWith(other_url))
+          << request_url << " " << other_url;
+      EXPECT_EQ(expected, ctx->IsInitiatorSameSiteWith(request_url))
+          << request_url << " " << other_url;
+    }
+  }
+}
+
+TEST(BraveRequestInfoTest, DomainsAreRecomputedWhenHostChanges) {
+  auto ctx = std::make_shared<BraveRequestInfo>(GURL("https://a.brave.com/"));
+  ctx->initiator_url = GURL("https://b.brave.com/");
+  EXPECT_EQ("brave.com", ctx->GetRequestDomain());
+  EXPECT_TRUE(ctx->IsRequestSameSiteWithInitiator());
+
+  ctx->request_url = GURL("https://a.example.com/");
+  EXPECT_EQ("example.com", ctx->GetRequestDomain());
+  EXPECT_FALSE(ctx->IsRequestSameSiteWithInitiator());
+
+  ctx->initiator_url = GURL("http://127.0.0.1/");
+  EXPECT_EQ("", ctx->GetInitiatorDomain());
+  ctx->tab_origin = GURL("https://user.github.io/");
+  EXPECT_EQ("user.github.io", ctx->GetTabOriginDomain());
+}
+
+}  // namespace brave
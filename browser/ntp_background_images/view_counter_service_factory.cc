@@ -61,11 +61,14 @@ KeyedService* ViewCounterServiceFactory::BuildServiceInstanceFor(
     if (ads_service) {
       is_supported_locale = ads_service->IsSupportedLocale();
     }
-    content::URLDataSource::Add(
-        browser_context,
-        std::make_unique<NTPBackgroundImagesSource>(service));
+    auto source = std::make_unique<NTPBackgroundImagesSource>(service);
+    // The source must observe |service| before the view counter, so that
+    // component updates clear its cache before the view counter prewarms it.
+    auto source_weak_ptr = source->GetWeakPtr();
+    content::URLDataSource::Add(browser_context, std::move(source));
 
-    return new ViewCounterService(service, ads_service, profile->GetPrefs(),
+    return new ViewCounterService(service, source_weak_ptr, ads_service,
+                                  profile->GetPrefs(),
                                   g_browser_process->local_state(),
                                   is_supported_locale);
   }
@@ -0,0 +1,186 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <vector>
+
+#include "base/time/time.h"
+#include "brave/browser/tor/tor_profile_manager.h"
+#include "brave/browser/tor/tor_profile_service_factory.h"
+#include "brave/components/tor/mock_tor_launcher_factory.h"
+#include "brave/components/tor/tor_profile_service.h"
+#include "chrome/test/base/testing_browser_process.h"
+#include "chrome/test/base/testing_profile.h"
+#include "chrome/test/base/testing_profile_manager.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/storage_partition.h"
+#include "content/public/test/browser_task_environment.h"
+#include "content/public/test/test_renderer_host.h"
+#include "content/public/test/web_contents_tester.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "net/base/network_isolation_key.h"
+#include "net/proxy_resolution/proxy_config_service.h"
+#include "services/network/test/test_network_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=TorProfileServiceUnitTest.*
+
+namespace tor {
+
+namespace {
+
+constexpr char kTestProfileName[] = "TestProfile";
+
+// Records the origins of the sockets the Tor profile asks to pre-warm
+class PreconnectRecordingNetworkContext : public network::TestNetworkContext {
+ public:
+  PreconnectRecordingNetworkContext() = default;
+  ~PreconnectRecordingNetworkContext() override = default;
+
+  PreconnectRecordingNetworkContext(const PreconnectRecordingNetworkContext&) =
+      delete;
+  PreconnectRecordingNetworkContext& operator=(
+      const PreconnectRecordingNetworkContext&) = delete;
+
+  // network::mojom::NetworkContext:
+  void PreconnectSockets(
+      uint32_t num_streams,
+      const GURL& url,
+      bool allow_credentials,
+      const net::NetworkIsolationKey& network_isolation_key) override {
+    preconnected_urls_.push_back(url);
+  }
+
+  const std::vector<GURL>& preconnected_urls() const {
+    return preconnected_urls_;
+  }
+
+ private:
+  std::vector<GURL> preconnected_urls_;
+};
+
+}  // namespace
+
+class TorProfileServiceUnitTest : public testing::Test {
+ public:
+  TorProfileServiceUnitTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+  ~TorProfileServiceUnitTest() override = default;
+
+  void SetUp() override {
+    TestingBrowserProcess* browser_process = TestingBrowserProcess::GetGlobal();
+    profile_manager_.reset(new TestingProfileManager(browser_process));
+    ASSERT_TRUE(profile_manager_->SetUp());
+    Profile* profile = profile_manager_->CreateTestingProfile(kTestProfileName);
+    tor_profile_ = TorProfileManager::GetInstance().GetTorProfile(profile);
+    ASSERT_EQ(tor_profile_->GetOriginalProfile(), profile);
+
+    tor_profile_service_ =
+        TorProfileServiceFactory::GetForContext(tor_profile_);
+    ASSERT_NE(tor_profile_service_, nullptr);
+    tor_profile_service_->SetTorLauncherFactoryForTest(GetTorLauncherFactory());
+    testing::Mock::AllowLeak(GetTorLauncherFactory());
+
+    // Needed by SetNewTorCircuit, which updates the circuit isolation
+    // credentials of the profile's proxy config
+    proxy_config_service_ = tor_profile_service_->CreateProxyConfigService();
+
+    content::BrowserContext::GetDefaultStoragePartition(tor_profile_)
+        ->SetNetworkContextForTesting(
+            network_context_receiver_.BindNewPipeAndPassRemote());
+  }
+
+  void TearDown() override {
+    testing::Mock::VerifyAndClearExpectations(GetTorLauncherFactory());
+    proxy_config_service_.reset();
+    profile_manager_->DeleteTestingProfile(kTestProfileName);
+  }
+
+ protected:
+  MockTorLauncherFactory* GetTorLauncherFactory() {
+    return &MockTorLauncherFactory::GetInstance();
+  }
+
+  void SetTorConnected(bool connected) {
+    EXPECT_CALL(*GetTorLauncherFactory(), IsTorConnected)
+        .WillRepeatedly(testing::Return(connected));
+  }
+
+  const std::vector<GURL>& PreconnectForURL(const GURL& url) {
+    tor_profile_service_->PreconnectForURL(url);
+    network_context_receiver_.FlushForTesting();
+    return network_context_.preconnected_urls();
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  content::RenderViewHostTestEnabler test_render_host_factories_;
+  std::unique_ptr<TestingProfileManager> profile_manager_;
+  Profile* tor_profile_ = nullptr;
+  TorProfileService* tor_profile_service_ = nullptr;
+  std::unique_ptr<net::ProxyConfigService> proxy_config_service_;
+  PreconnectRecordingNetworkContext network_context_;
+  mojo::Receiver<network::mojom::NetworkContext> network_context_receiver_{
+      &network_context_};
+};
+
+TEST_F(TorProfileServiceUnitTest, PreconnectOnlyOnceTorIsConnected) {
+  SetTorConnected(false);
+  EXPECT_TRUE(PreconnectForURL(GURL("https://a.com/")).empty());
+
+  SetTorConnected(true);
+  EXPECT_EQ(PreconnectForURL(GURL("https://a.com/")),
+            std::vector<GURL>({GURL("https://a.com/")}));
+}
+
+TEST_F(TorProfileServiceUnitTest, PreconnectOnlyForHttpAndHttps) {
+  SetTorConnected(true);
+  EXPECT_TRUE(PreconnectForURL(GURL("chrome://settings")).empty());
+  EXPECT_TRUE(PreconnectForURL(GURL("file:///tmp/a.html")).empty());
+  EXPECT_TRUE(PreconnectForURL(GURL("ftp://a.com/file")).empty());
+  EXPECT_TRUE(PreconnectForURL(GURL("wss://a.com/socket")).empty());
+
+  PreconnectForURL(GURL("http://a.com/path"));
+  EXPECT_EQ(PreconnectForURL(GURL("https://a.com/path")),
+            std::vector<GURL>({GURL("http://a.com/"), GURL("https://a.com/")}));
+}
+
+TEST_F(TorProfileServiceUnitTest, PreconnectOncePerSiteInInterval) {
+  SetTorConnected(true);
+  PreconnectForURL(GURL("https://a.com/1"));
+  PreconnectForURL(GURL("https://a.com/2"));
+  PreconnectForURL(GURL("https://sub.a.com/"));
+  EXPECT_EQ(
+      PreconnectForURL(GURL("https://b.com/")),
+      std::vector<GURL>({GURL("https://a.com/"), GURL("https://b.com/")}));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(9));
+  EXPECT_EQ(PreconnectForURL(GURL("https://a.com/3")).size(), 2u);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(PreconnectForURL(GURL("https://a.com/3")),
+            std::vector<GURL>({GURL("https://a.com/"), GURL("https://b.com/"),
+                               GURL("https://a.com/")}));
+}
+
+TEST_F(TorProfileServiceUnitTest, SetNewTorCircuitForgetsPreconnectedSite) {
+  SetTorConnected(true);
+  PreconnectForURL(GURL("https://a.com/"));
+  PreconnectForURL(GURL("https://b.com/"));
+
+  std::unique_ptr<content::WebContents> web_contents =
+      content::WebContentsTester::CreateTestWebContents(tor_profile_, nullptr);
+  content::WebContentsTester::For(web_contents.get())
+      ->NavigateAndCommit(GURL("https://a.com/page"));
+  tor_profile_service_->SetNewTorCircuit(web_contents.get());
+
+  // Only the site of the tab gets a new circuit
+  EXPECT_EQ(PreconnectForURL(GURL("https://b.com/")).size(), 2u);
+  EXPECT_EQ(PreconnectForURL(GURL("https://a.com/")),
+            std::vector<GURL>({GURL("https://a.com/"), GURL("https://b.com/"),
+                               GURL("https://a.com/")}));
+}
+
+}  // namespace tor
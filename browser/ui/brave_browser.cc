@@ -5,6 +5,8 @@
 
 #include "brave/browser/ui/brave_browser.h"
 
+#include "brave/components/tor/buildflags/buildflags.h"
+
 #if BUILDFLAG(ENABLE_SIDEBAR)
 #include "brave/browser/ui/brave_browser_window.h"
 #include "brave/browser/ui/sidebar/sidebar.h"
@@ -14,6 +16,12 @@
 #include "chrome/browser/ui/tabs/tab_strip_model_observer.h"
 #endif
 
+#if BUILDFLAG(ENABLE_TOR)
+#include "brave/browser/tor/tor_profile_service_factory.h"
+#include "brave/components/tor/tor_profile_service.h"
+#include "chrome/browser/profiles/profile.h"
+#endif
+
 BraveBrowser::BraveBrowser(const CreateParams& params) : Browser(params) {
 #if BUILDFLAG(ENABLE_SIDEBAR)
   if (!sidebar::CanUseSidebar(profile()) || !is_type_normal())
@@ -62,6 +70,22 @@ void BraveBrowser::OnTabStripModelChanged(
 #endif
 }
 
+void BraveBrowser::UpdateTargetURL(content::WebContents* source,
+                                   const GURL& url) {
+  Browser::UpdateTargetURL(source, url);
+
+#if BUILDFLAG(ENABLE_TOR)
+  // Hovering a link in a Tor window pre-warms a connection for its site
+  if (url.is_empty() || !profile()->IsTor())
+    return;
+
+  tor::TorProfileService* service =
+      TorProfileServiceFactory::GetForContext(profile());
+  if (service)
+    service->PreconnectForURL(url);
+#endif
+}
+
 BraveBrowserWindow* BraveBrowser::brave_window() {
   return static_cast<BraveBrowserWindow*>(window_);
 }
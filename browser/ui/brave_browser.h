@@ -34,6 +34,7 @@ class BraveBrowser : public Browser {
       TabStripModel* tab_strip_model,
       const TabStripModelChange& change,
       const TabStripSelectionChange& selection) override;
+  void UpdateTargetURL(content::WebContents* source, const GURL& url) override;
 
 #if BUILDFLAG(ENABLE_SIDEBAR)
   sidebar::SidebarController* sidebar_controller() {
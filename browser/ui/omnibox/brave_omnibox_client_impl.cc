@@ -12,14 +12,21 @@
 #include "base/values.h"
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/tor/buildflags/buildflags.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_edit_controller.h"
 #include "components/omnibox/browser/autocomplete_match.h"
+#include "components/omnibox/browser/autocomplete_result.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 
+#if BUILDFLAG(ENABLE_TOR)
+#include "brave/browser/tor/tor_profile_service_factory.h"
+#include "brave/components/tor/tor_profile_service.h"
+#endif
+
 namespace {
 
 constexpr char kSearchCountPrefName[] = "brave.weekly_storage.search_count";
@@ -90,3 +97,23 @@ void BraveOmniboxClientImpl::OnInputAccepted(const AutocompleteMatch& match) {
     RecordSearchEventP3A(storage.GetWeeklySum());
   }
 }
+
+void BraveOmniboxClientImpl::OnResultChanged(
+    const AutocompleteResult& result,
+    bool default_match_changed,
+    const BitmapFetchedCallback& on_bitmap_fetched) {
+  ChromeOmniboxClient::OnResultChanged(result, default_match_changed,
+                                       on_bitmap_fetched);
+
+#if BUILDFLAG(ENABLE_TOR)
+  // The loading predictor doesn't preconnect for off the record profiles, so
+  // Tor windows pre-warm a connection for the default match themselves
+  if (!profile_->IsTor() || !default_match_changed || !result.default_match())
+    return;
+
+  tor::TorProfileService* service =
+      TorProfileServiceFactory::GetForContext(profile_);
+  if (service)
+    service->PreconnectForURL(result.default_match()->destination_url);
+#endif
+}
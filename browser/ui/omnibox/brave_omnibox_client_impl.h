@@ -24,6 +24,9 @@ class BraveOmniboxClientImpl : public ChromeOmniboxClient {
   bool IsAutocompleteEnabled() const override;
 
   void OnInputAccepted(const AutocompleteMatch& match) override;
+  void OnResultChanged(const AutocompleteResult& result,
+                       bool default_match_changed,
+                       const BitmapFetchedCallback& on_bitmap_fetched) override;
 
  private:
   Profile* profile_;
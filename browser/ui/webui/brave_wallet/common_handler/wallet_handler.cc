@@ -45,6 +45,8 @@ void WalletHandler::GetWalletInfo(GetWalletInfoCallback callback) {
   auto* default_keyring = keyring_controller->GetDefaultKeyring();
   if (default_keyring) {
     accounts = default_keyring->GetAccounts();
+  } else {
+    accounts = keyring_controller->GetCachedAccountsForDefaultKeyring();
   }
 
   std::vector<wallet_ui::mojom::AppItemPtr> favorite_apps_copy(
@@ -71,8 +73,7 @@ void WalletHandler::UnlockWallet(const std::string& password,
   auto* profile = Profile::FromWebUI(web_ui_);
   auto* keyring_controller =
       GetBraveWalletService(profile)->keyring_controller();
-  bool result = keyring_controller->Unlock(password);
-  std::move(callback).Run(result);
+  keyring_controller->Unlock(password, std::move(callback));
 }
 
 void WalletHandler::AddFavoriteApp(
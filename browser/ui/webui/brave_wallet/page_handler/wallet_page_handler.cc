@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "brave/browser/brave_wallet/brave_wallet_service_factory.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
@@ -44,11 +45,16 @@ void WalletPageHandler::CreateWallet(const std::string& password,
   auto* browser_context = web_ui_->GetWebContents()->GetBrowserContext();
   auto* keyring_controller =
       GetBraveWalletService(browser_context)->keyring_controller();
-  auto* keyring = keyring_controller->CreateDefaultKeyring(password);
-  if (keyring) {
-    keyring->AddAccounts();
-  }
-  std::move(callback).Run(keyring_controller->GetMnemonicForDefaultKeyring());
+  // The controller only runs the callback while it is alive
+  keyring_controller->CreateDefaultKeyring(
+      password,
+      base::BindOnce(
+          [](brave_wallet::KeyringController* keyring_controller,
+             CreateWalletCallback callback, brave_wallet::HDKeyring*) {
+            std::move(callback).Run(
+                keyring_controller->GetMnemonicForDefaultKeyring());
+          },
+          keyring_controller, std::move(callback)));
 }
 
 void WalletPageHandler::GetRecoveryWords(GetRecoveryWordsCallback callback) {
@@ -60,14 +66,20 @@ void WalletPageHandler::GetRecoveryWords(GetRecoveryWordsCallback callback) {
 }
 
 void WalletPageHandler::RestoreWallet(const std::string& mnemonic,
-                                      const std::string& password) {
+                                      const std::string& password,
+                                      RestoreWalletCallback callback) {
   auto* browser_context = web_ui_->GetWebContents()->GetBrowserContext();
   auto* keyring_controller =
       GetBraveWalletService(browser_context)->keyring_controller();
-  auto* keyring = keyring_controller->RestoreDefaultKeyring(mnemonic, password);
-  if (keyring) {
-    keyring->AddAccounts();
-  }
+  // Reply once the restored keyring is installed so that the page does not
+  // read the wallet state in between
+  keyring_controller->RestoreDefaultKeyring(
+      mnemonic, password,
+      base::BindOnce(
+          [](RestoreWalletCallback callback, brave_wallet::HDKeyring* keyring) {
+            std::move(callback).Run(keyring != nullptr);
+          },
+          std::move(callback)));
 }
 
 void WalletPageHandler::OnVisibilityChanged(content::Visibility visibility) {
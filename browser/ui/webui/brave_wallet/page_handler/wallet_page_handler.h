@@ -39,7 +39,8 @@ class WalletPageHandler : public wallet_ui::mojom::PageHandler,
   // wallet_ui::mojom::PageHandler:
   void CreateWallet(const std::string& password, CreateWalletCallback) override;
   void RestoreWallet(const std::string& mnemonic,
-                     const std::string& password) override;
+                     const std::string& password,
+                     RestoreWalletCallback callback) override;
   void GetRecoveryWords(GetRecoveryWordsCallback) override;
 
  private:
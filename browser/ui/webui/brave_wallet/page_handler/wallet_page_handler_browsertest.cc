@@ -0,0 +1,112 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/browser/ui/webui/brave_wallet/page_handler/wallet_page_handler.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "brave/browser/ui/webui/brave_wallet/common_handler/wallet_handler.h"
+#include "brave/components/brave_wallet_ui/wallet_ui.mojom.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/test_web_ui.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
+
+// npm run test -- brave_browser_tests --filter=WalletPageHandlerBrowserTest.*
+
+namespace {
+
+constexpr char kMnemonic[] =
+    "divide cruise upon flag harsh carbon filter merit once advice bright "
+    "drive";
+
+mojo::PendingRemote<wallet_ui::mojom::Page> CreatePageRemote() {
+  mojo::PendingRemote<wallet_ui::mojom::Page> page;
+  ignore_result(page.InitWithNewPipeAndPassReceiver());
+  return page;
+}
+
+}  // namespace
+
+class WalletPageHandlerBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    web_ui_.set_web_contents(
+        browser()->tab_strip_model()->GetActiveWebContents());
+
+    page_handler_ = std::make_unique<WalletPageHandler>(
+        page_handler_remote_.BindNewPipeAndPassReceiver(), CreatePageRemote(),
+        &web_ui_, nullptr);
+    wallet_handler_ = std::make_unique<WalletHandler>(
+        wallet_handler_remote_.BindNewPipeAndPassReceiver(),
+        CreatePageRemote(), &web_ui_, nullptr);
+  }
+
+  void TearDownOnMainThread() override {
+    wallet_handler_.reset();
+    page_handler_.reset();
+  }
+
+ protected:
+  content::TestWebUI web_ui_;
+  mojo::Remote<wallet_ui::mojom::PageHandler> page_handler_remote_;
+  mojo::Remote<wallet_ui::mojom::WalletHandler> wallet_handler_remote_;
+  std::unique_ptr<WalletPageHandler> page_handler_;
+  std::unique_ptr<WalletHandler> wallet_handler_;
+};
+
+IN_PROC_BROWSER_TEST_F(WalletPageHandlerBrowserTest,
+                       GetWalletInfoRightAfterRestore) {
+  bool restored = false;
+  bool is_wallet_created = false;
+  bool is_wallet_locked = true;
+  std::vector<std::string> wallet_accounts;
+
+  // Same as the page, which asks for the wallet info once the restore
+  // resolves
+  base::RunLoop run_loop;
+  page_handler_remote_->RestoreWallet(
+      kMnemonic, "brave", base::BindLambdaForTesting([&](bool success) {
+        restored = success;
+        wallet_handler_remote_->GetWalletInfo(base::BindLambdaForTesting(
+            [&](bool is_created, bool is_locked,
+                std::vector<wallet_ui::mojom::AppItemPtr> favorite_apps,
+                bool is_backed_up, const std::vector<std::string>& accounts) {
+              is_wallet_created = is_created;
+              is_wallet_locked = is_locked;
+              wallet_accounts = accounts;
+              run_loop.Quit();
+            }));
+      }));
+  run_loop.Run();
+
+  EXPECT_TRUE(restored);
+  EXPECT_TRUE(is_wallet_created);
+  EXPECT_FALSE(is_wallet_locked);
+  EXPECT_EQ(wallet_accounts,
+            std::vector<std::string>(
+                {"0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db"}));
+}
+
+IN_PROC_BROWSER_TEST_F(WalletPageHandlerBrowserTest, RestoreWithoutPassword) {
+  bool restored = true;
+  base::RunLoop run_loop;
+  page_handler_remote_->RestoreWallet(
+      kMnemonic, "", base::BindLambdaForTesting([&](bool success) {
+        restored = success;
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+
+  EXPECT_FALSE(restored);
+}
@@ -0,0 +1,190 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "net/cookies/cookie_monster.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_deletion_info.h"
+#include "net/cookies/cookie_options.h"
+#include "net/cookies/cookie_store_test_callbacks.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+class BraveEphemeralCookieMonsterTest : public testing::Test {
+ public:
+  BraveEphemeralCookieMonsterTest()
+      : cookie_monster_(nullptr /* store */, nullptr /* net_log */) {}
+
+ protected:
+  GURL GetTopFrameURL(int index) {
+    return GURL(base::StringPrintf("https://site%d.com", index));
+  }
+
+  void SetEphemeralCookie(const GURL& top_frame_url) {
+    std::unique_ptr<CanonicalCookie> cookie(CanonicalCookie::Create(
+        embedded_url_, "a=b", base::Time::Now(), base::nullopt));
+    ResultSavingCookieCallback<CookieAccessResult> callback;
+    cookie_monster_.SetEphemeralCanonicalCookieAsync(
+        std::move(cookie), embedded_url_, top_frame_url,
+        CookieOptions::MakeAllInclusive(), callback.MakeCallback());
+    callback.WaitUntilDone();
+    ASSERT_TRUE(callback.result().status.IsInclude());
+  }
+
+  size_t GetEphemeralCookieCount(const GURL& top_frame_url) {
+    GetCookieListCallback callback;
+    cookie_monster_.GetEphemeralCookieListWithOptionsAsync(
+        embedded_url_, top_frame_url, CookieOptions::MakeAllInclusive(),
+        callback.MakeCallback());
+    callback.WaitUntilDone();
+    return callback.cookies().size();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  const GURL embedded_url_ = GURL("https://embedded.com");
+  CookieMonster cookie_monster_;
+};
+
+TEST_F(BraveEphemeralCookieMonsterTest, ReadsDoNotCreateStores) {
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(0u, cookie_monster_.ephemeral_cookie_store_count());
+
+  SetEphemeralCookie(GetTopFrameURL(0));
+  EXPECT_EQ(1u, cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(1)));
+  EXPECT_EQ(1u, cookie_monster_.ephemeral_cookie_store_count());
+}
+
+TEST_F(BraveEphemeralCookieMonsterTest, EvictsLeastRecentlyUsedStore) {
+  const int kStoreCount =
+      static_cast<int>(CookieMonster::kMaxEphemeralCookieStores);
+  for (int i = 0; i < kStoreCount; ++i)
+    SetEphemeralCookie(GetTopFrameURL(i));
+  EXPECT_EQ(CookieMonster::kMaxEphemeralCookieStores,
+            cookie_monster_.ephemeral_cookie_store_count());
+
+  // Using the first store makes the second one the least recently used.
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  SetEphemeralCookie(GetTopFrameURL(kStoreCount));
+
+  EXPECT_EQ(CookieMonster::kMaxEphemeralCookieStores,
+            cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(1)));
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(kStoreCount)));
+}
+
+TEST_F(BraveEphemeralCookieMonsterTest, KeepsStoreOfLiveFrame) {
+  bool is_alive = true;
+  const int accessor = 0;
+  cookie_monster_.KeepEphemeralCookieStoreAlive(
+      GetTopFrameURL(0), &accessor,
+      base::BindRepeating([](const bool* is_alive) { return *is_alive; },
+                          &is_alive));
+  SetEphemeralCookie(GetTopFrameURL(0));
+
+  // The store of the live frame is the least recently used one throughout.
+  const int kStoreCount =
+      static_cast<int>(CookieMonster::kMaxEphemeralCookieStores) * 2;
+  for (int i = 1; i <= kStoreCount; ++i)
+    SetEphemeralCookie(GetTopFrameURL(i));
+
+  EXPECT_EQ(CookieMonster::kMaxEphemeralCookieStores,
+            cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(1)));
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(kStoreCount)));
+
+  // Once the frame is gone its store is evicted like any other.
+  is_alive = false;
+  for (int i = kStoreCount + 1; i <= kStoreCount * 2; ++i)
+    SetEphemeralCookie(GetTopFrameURL(i));
+
+  EXPECT_EQ(CookieMonster::kMaxEphemeralCookieStores,
+            cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+}
+
+TEST_F(BraveEphemeralCookieMonsterTest, TrimsStoresUnderMemoryPressure) {
+  bool is_alive = true;
+  const int accessor = 0;
+  cookie_monster_.KeepEphemeralCookieStoreAlive(
+      GetTopFrameURL(0), &accessor,
+      base::BindRepeating([](const bool* is_alive) { return *is_alive; },
+                          &is_alive));
+
+  const int kStoreCount =
+      static_cast<int>(CookieMonster::kMaxEphemeralCookieStores);
+  for (int i = 0; i < kStoreCount; ++i)
+    SetEphemeralCookie(GetTopFrameURL(i));
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  task_environment_.RunUntilIdle();
+
+  // The most recently used stores and the one of the live frame are kept.
+  EXPECT_EQ(CookieMonster::kMaxEphemeralCookieStores / 2,
+            cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(1)));
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(kStoreCount - 1)));
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(1u, cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+}
+
+TEST_F(BraveEphemeralCookieMonsterTest, DeletesStoresByDomain) {
+  const int kStoreCount = 1000;
+  for (int i = 0; i < kStoreCount; ++i)
+    SetEphemeralCookie(GetTopFrameURL(i));
+
+  for (int i = 0; i < kStoreCount; i += 2) {
+    CookieDeletionInfo delete_info;
+    delete_info.ephemeral_storage_domain =
+        base::StringPrintf("site%d.com", i);
+    ResultSavingCookieCallback<uint32_t> callback;
+    cookie_monster_.DeleteAllMatchingInfoAsync(std::move(delete_info),
+                                               callback.MakeCallback());
+    callback.WaitUntilDone();
+  }
+
+  EXPECT_EQ(static_cast<size_t>(kStoreCount / 2),
+            cookie_monster_.ephemeral_cookie_store_count());
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GetTopFrameURL(1)));
+}
+
+TEST_F(BraveEphemeralCookieMonsterTest, DeletesMatchingCookiesFromAllStores) {
+  const int kStoreCount = 1000;
+  for (int i = 0; i < kStoreCount; ++i)
+    SetEphemeralCookie(GetTopFrameURL(i));
+
+  CookieDeletionInfo delete_info;
+  delete_info.host = embedded_url_.host();
+  ResultSavingCookieCallback<uint32_t> callback;
+  cookie_monster_.DeleteAllMatchingInfoAsync(std::move(delete_info),
+                                             callback.MakeCallback());
+  callback.WaitUntilDone();
+
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(0)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GetTopFrameURL(kStoreCount - 1)));
+}
+
+}  // namespace net
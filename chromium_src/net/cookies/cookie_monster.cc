@@ -6,6 +6,9 @@
 #include "net/cookies/cookie_monster.h"
 
 #include <memory>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
 #include "net/base/url_util.h"
 
 #define CookieMonster ChromiumCookieMonster
@@ -14,33 +17,116 @@
 
 namespace net {
 
+const size_t CookieMonster::kMaxEphemeralCookieStores = 1000;
+
 CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
                              NetLog* net_log)
     : ChromiumCookieMonster(store, net_log),
-      net_log_(
-          NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)) {}
+      net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)),
+      ephemeral_cookie_stores_(
+          base::MRUCache<std::string, std::unique_ptr<ChromiumCookieMonster>>::
+              NO_AUTO_EVICT),
+      memory_pressure_listener_(std::make_unique<base::MemoryPressureListener>(
+          FROM_HERE,
+          base::BindRepeating(&CookieMonster::OnMemoryPressure,
+                              base::Unretained(this)))) {}
 
 CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
                              base::TimeDelta last_access_threshold,
                              NetLog* net_log)
     : ChromiumCookieMonster(store, last_access_threshold, net_log),
-      net_log_(
-          NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)) {}
+      net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)),
+      ephemeral_cookie_stores_(
+          base::MRUCache<std::string, std::unique_ptr<ChromiumCookieMonster>>::
+              NO_AUTO_EVICT),
+      memory_pressure_listener_(std::make_unique<base::MemoryPressureListener>(
+          FROM_HERE,
+          base::BindRepeating(&CookieMonster::OnMemoryPressure,
+                              base::Unretained(this)))) {}
 
 CookieMonster::~CookieMonster() {}
 
+ChromiumCookieMonster* CookieMonster::GetEphemeralCookieStoreForTopFrameURL(
+    const GURL& top_frame_url) {
+  auto it =
+      ephemeral_cookie_stores_.Get(URLToEphemeralStorageDomain(top_frame_url));
+  if (it != ephemeral_cookie_stores_.end())
+    return it->second.get();
+
+  if (!empty_ephemeral_cookie_store_) {
+    empty_ephemeral_cookie_store_ = std::make_unique<ChromiumCookieMonster>(
+        nullptr /* store */, net_log_.net_log());
+  }
+  return empty_ephemeral_cookie_store_.get();
+}
+
 ChromiumCookieMonster*
 CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
     const GURL& top_frame_url) {
   std::string domain = URLToEphemeralStorageDomain(top_frame_url);
-  auto it = ephemeral_cookie_stores_.find(domain);
+  auto it = ephemeral_cookie_stores_.Get(domain);
   if (it != ephemeral_cookie_stores_.end())
     return it->second.get();
 
-  return ephemeral_cookie_stores_
-      .emplace(domain, new ChromiumCookieMonster(nullptr /* store */,
-                                                 net_log_.net_log()))
-      .first->second.get();
+  ChromiumCookieMonster* ephemeral_monster =
+      ephemeral_cookie_stores_
+          .Put(domain, std::make_unique<ChromiumCookieMonster>(
+                           nullptr /* store */, net_log_.net_log()))
+          ->second.get();
+  EvictEphemeralCookieStores(domain, kMaxEphemeralCookieStores);
+  return ephemeral_monster;
+}
+
+void CookieMonster::KeepEphemeralCookieStoreAlive(
+    const GURL& top_frame_url,
+    const void* accessor,
+    base::RepeatingCallback<bool()> is_alive) {
+  ephemeral_cookie_store_accessors_[URLToEphemeralStorageDomain(
+      top_frame_url)][accessor] = std::move(is_alive);
+}
+
+bool CookieMonster::HasLiveEphemeralCookieStoreAccessor(
+    const std::string& domain) {
+  auto it = ephemeral_cookie_store_accessors_.find(domain);
+  if (it == ephemeral_cookie_store_accessors_.end())
+    return false;
+
+  base::EraseIf(it->second,
+                [](const auto& accessor) { return !accessor.second.Run(); });
+  if (it->second.empty()) {
+    ephemeral_cookie_store_accessors_.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void CookieMonster::EvictEphemeralCookieStores(const std::string& domain,
+                                               size_t max_count) {
+  // Stores of frames which are still alive are kept even past the limit, as
+  // those frames would otherwise lose cookies they have just set.
+  auto it = ephemeral_cookie_stores_.rbegin();
+  while (ephemeral_cookie_stores_.size() > max_count &&
+         it != ephemeral_cookie_stores_.rend()) {
+    if (it->first == domain || HasLiveEphemeralCookieStoreAccessor(it->first)) {
+      ++it;
+      continue;
+    }
+    it = ephemeral_cookie_stores_.Erase(it);
+  }
+}
+
+void CookieMonster::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      EvictEphemeralCookieStores(std::string(), kMaxEphemeralCookieStores / 2);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      EvictEphemeralCookieStores(std::string(), 0);
+      break;
+  }
 }
 
 void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
@@ -66,7 +152,12 @@ void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
 void CookieMonster::DeleteAllMatchingInfoAsync(CookieDeletionInfo delete_info,
                                                DeleteCallback callback) {
   if (delete_info.ephemeral_storage_domain.has_value()) {
-    ephemeral_cookie_stores_.erase(*delete_info.ephemeral_storage_domain);
+    auto it =
+        ephemeral_cookie_stores_.Peek(*delete_info.ephemeral_storage_domain);
+    if (it != ephemeral_cookie_stores_.end())
+      ephemeral_cookie_stores_.Erase(it);
+    ephemeral_cookie_store_accessors_.erase(
+        *delete_info.ephemeral_storage_domain);
     std::move(callback).Run(0);
     return;
   }
@@ -100,7 +191,7 @@ void CookieMonster::GetEphemeralCookieListWithOptionsAsync(
     const CookieOptions& options,
     GetCookieListCallback callback) {
   ChromiumCookieMonster* ephemeral_monster =
-      GetOrCreateEphemeralCookieStoreForTopFrameURL(top_frame_url);
+      GetEphemeralCookieStoreForTopFrameURL(top_frame_url);
   ephemeral_monster->GetCookieListWithOptionsAsync(url, options,
                                                    std::move(callback));
 }
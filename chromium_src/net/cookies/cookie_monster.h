@@ -6,6 +6,14 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 
+#include <map>
+#include <string>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/memory_pressure_listener.h"
+
 #define CookieMonster ChromiumCookieMonster
 #include "../../../../net/cookies/cookie_monster.h"
 #undef CookieMonster
@@ -14,6 +22,15 @@ namespace net {
 
 class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
  public:
+  // Upper bound on the number of ephemeral cookie stores. Stores for top
+  // frames which haven't used their ephemeral cookies for the longest time are
+  // dropped first, unless a frame which set cookies in them is still alive.
+  // Each store is itself bounded by Chromium's per-monster cookie limits.
+  // Under moderate memory pressure the stores are trimmed to half this limit,
+  // and under critical memory pressure every store without a live frame is
+  // dropped.
+  static const size_t kMaxEphemeralCookieStores;
+
   // These constructors and destructors must be kept in sync with those in
   // Chromium's CookieMonster.
   CookieMonster(scoped_refptr<PersistentCookieStore> store, NetLog* net_log);
@@ -47,10 +64,40 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
                                         const CookieOptions& options,
                                         SetCookiesCallback callback);
 
+  // Keeps the ephemeral cookie store of |top_frame_url| from being evicted
+  // while |is_alive| returns true. |accessor| identifies the caller, e.g. the
+  // restricted cookie manager of a frame, so that repeated calls from the same
+  // caller replace each other.
+  void KeepEphemeralCookieStoreAlive(const GURL& top_frame_url,
+                                     const void* accessor,
+                                     base::RepeatingCallback<bool()> is_alive);
+
+  size_t ephemeral_cookie_store_count() const {
+    return ephemeral_cookie_stores_.size();
+  }
+
  private:
   NetLogWithSource net_log_;
-  std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
+  // Keyed by ephemeral storage domain, most recently used first.
+  base::MRUCache<std::string, std::unique_ptr<ChromiumCookieMonster>>
       ephemeral_cookie_stores_;
+  // Callbacks telling whether the accessors of each ephemeral storage domain
+  // are still alive. Stores with a live accessor are never evicted.
+  std::map<std::string,
+           base::flat_map<const void*, base::RepeatingCallback<bool()>>>
+      ephemeral_cookie_store_accessors_;
+  // Answers reads for top frames which have no ephemeral cookies, so that a
+  // store is only allocated once a cookie is actually set.
+  std::unique_ptr<ChromiumCookieMonster> empty_ephemeral_cookie_store_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  bool HasLiveEphemeralCookieStoreAccessor(const std::string& domain);
+  // Evicts the least recently used stores without live accessors, other than
+  // the one of |domain|, until at most |max_count| stores are left.
+  void EvictEphemeralCookieStores(const std::string& domain, size_t max_count);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  ChromiumCookieMonster* GetEphemeralCookieStoreForTopFrameURL(
+      const GURL& top_frame_url);
   ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
       const GURL& top_frame_url);
 };
@@ -5,7 +5,9 @@
 
 #include "services/network/restricted_cookie_manager.h"
 
+#include "base/bind.h"
 #include "base/feature_list.h"
+#include "base/memory/weak_ptr.h"
 #include "components/content_settings/core/common/cookie_settings_base.h"
 #include "net/base/features.h"
 #include "net/cookies/cookie_monster.h"
@@ -25,6 +27,11 @@ bool ShouldUseEphemeralStorage(
       url, site_for_cookies.RepresentativeUrl(), top_frame_origin);
 }
 
+bool IsRestrictedCookieManagerAlive(
+    base::WeakPtr<network::RestrictedCookieManager> manager) {
+  return !!manager;
+}
+
 }  // namespace
 
 #define BRAVE_GETALLFORURL                                                  \
@@ -44,7 +51,13 @@ bool ShouldUseEphemeralStorage(
 #define BRAVE_SETCANONICALCOOKIE                                               \
   if (ShouldUseEphemeralStorage(url, top_frame_origin, site_for_cookies,       \
                                 cookie_settings_)) {                           \
-    static_cast<net::CookieMonster*>(cookie_store_)                            \
+    net::CookieMonster* cookie_monster =                                       \
+        static_cast<net::CookieMonster*>(cookie_store_);                       \
+    cookie_monster->KeepEphemeralCookieStoreAlive(                             \
+        top_frame_origin.GetURL(), this,                                       \
+        base::BindRepeating(&IsRestrictedCookieManagerAlive,                   \
+                            weak_ptr_factory_.GetWeakPtr()));                  \
+    cookie_monster                                                             \
         ->SetEphemeralCanonicalCookieAsync(                                    \
             std::move(sanitized_cookie), origin_.GetURL(),                     \
             top_frame_origin.GetURL(), options,                                \
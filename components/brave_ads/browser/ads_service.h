@@ -57,6 +57,10 @@ using GetAccountStatementCallback = base::OnceCallback<void(const bool,
                                                             const double,
                                                             const double)>;
 
+using ShouldLoadPageContentCallback =
+    base::OnceCallback<void(const bool should_load_html,
+                            const bool should_load_text)>;
+
 class AdsService : public KeyedService {
  public:
   AdsService();
@@ -94,6 +98,9 @@ class AdsService : public KeyedService {
 
   virtual void ChangeLocale(const std::string& locale) = 0;
 
+  virtual void ShouldLoadPageContent(const std::vector<GURL>& redirect_chain,
+                                     ShouldLoadPageContentCallback callback) = 0;
+
   virtual void OnHtmlLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
                             const std::string& html) = 0;
@@ -27,11 +27,13 @@
 #include "base/path_service.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "bat/ads/ad_history_info.h"
 #include "bat/ads/ad_notification_info.h"
 #include "bat/ads/ads.h"
@@ -117,6 +119,20 @@ constexpr char kAdNotificationUrlPrefix[] = "https://www.brave.com/ads/?";
 static std::map<std::string, int> g_schema_resource_ids = {
     {ads::g_catalog_schema_resource_id, IDR_ADS_CATALOG_SCHEMA}};
 
+constexpr char kAdsPrefPathPrefix[] = "brave.brave_ads.";
+
+void AddAdsPref(base::flat_map<std::string, base::Value>* prefs,
+                const std::string& path,
+                const base::Value& value) {
+  DCHECK(prefs);
+
+  if (!base::StartsWith(path, kAdsPrefPathPrefix)) {
+    return;
+  }
+
+  prefs->insert({path, value.Clone()});
+}
+
 int GetSchemaResourceId(const std::string& name) {
   if (g_schema_resource_ids.find(name) != g_schema_resource_ids.end()) {
     return g_schema_resource_ids[name];
@@ -304,7 +320,28 @@ void AdsServiceImpl::OnPrefChanged(const std::string& path) {
     return;
   }
 
-  bat_ads_->OnPrefChanged(path);
+  const base::Value* value = profile_->GetPrefs()->Get(path);
+  DCHECK(value);
+
+  bat_ads_->OnPrefChanged(path, value->Clone());
+}
+
+void AdsServiceImpl::ShouldLoadPageContent(
+    const std::vector<GURL>& redirect_chain,
+    ShouldLoadPageContentCallback callback) {
+  if (!connected()) {
+    std::move(callback).Run(/* should_load_html */ false,
+                            /* should_load_text */ false);
+    return;
+  }
+
+  std::vector<std::string> redirect_chain_as_strings;
+  for (const auto& url : redirect_chain) {
+    redirect_chain_as_strings.push_back(url.spec());
+  }
+
+  bat_ads_->ShouldLoadPageContent(redirect_chain_as_strings,
+                                  std::move(callback));
 }
 
 void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
@@ -659,8 +696,12 @@ void AdsServiceImpl::OnCreate() {
     return;
   }
 
+  base::flat_map<std::string, base::Value> prefs;
+  profile_->GetPrefs()->IteratePreferenceValues(
+      base::BindRepeating(&AddAdsPref, &prefs));
+
   auto callback = base::BindOnce(&AdsServiceImpl::OnInitialize, AsWeakPtr());
-  bat_ads_->Initialize(base::BindOnce(std::move(callback)));
+  bat_ads_->Initialize(std::move(prefs), base::BindOnce(std::move(callback)));
 }
 
 void AdsServiceImpl::OnInitialize(const int32_t result) {
@@ -1928,11 +1969,9 @@ void AdsServiceImpl::LoadAdsResource(const std::string& id,
 
   VLOG(1) << "Loading ads resource from " << path.value();
 
-  base::PostTaskAndReplyWithResult(
-      file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&LoadOnFileTaskRunner, path.value()),
-      base::BindOnce(&AdsServiceImpl::OnLoaded, AsWeakPtr(),
-                     std::move(callback)));
+  resource_loader_.Load(id, path.value(),
+                        base::BindOnce(&AdsServiceImpl::OnLoaded, AsWeakPtr(),
+                                       std::move(callback)));
 }
 
 void AdsServiceImpl::GetBrowsingHistory(
@@ -2003,7 +2042,16 @@ void AdsServiceImpl::Load(const std::string& name, ads::LoadCallback callback) {
 
 std::string AdsServiceImpl::LoadResourceForId(const std::string& id) {
   const auto resource_id = GetSchemaResourceId(id);
-  return LoadDataResourceAndDecompressIfNeeded(resource_id);
+
+  auto iter = data_resources_.find(resource_id);
+  if (iter == data_resources_.end()) {
+    iter = data_resources_
+               .emplace(resource_id,
+                        LoadDataResourceAndDecompressIfNeeded(resource_id))
+               .first;
+  }
+
+  return iter->second;
 }
 
 ads::DBCommandResponsePtr RunDBTransactionOnFileTaskRunner(
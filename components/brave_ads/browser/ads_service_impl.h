@@ -26,6 +26,7 @@
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/background_helper.h"
 #include "brave/components/brave_ads/browser/component_updater/resource_component.h"
+#include "brave/components/brave_ads/browser/component_updater/resource_loader.h"
 #include "brave/components/brave_ads/browser/notification_helper.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_observer.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
@@ -109,6 +110,9 @@ class AdsServiceImpl : public AdsService,
 
   void OnPrefChanged(const std::string& path);
 
+  void ShouldLoadPageContent(const std::vector<GURL>& redirect_chain,
+                             ShouldLoadPageContentCallback callback) override;
+
   void OnHtmlLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
                     const std::string& html) override;
@@ -420,6 +424,12 @@ class AdsServiceImpl : public AdsService,
 
   const base::FilePath base_path_;
 
+  // Data resources are compiled into the resource bundle, so are only
+  // decompressed the first time they are requested
+  std::map<int, std::string> data_resources_;
+
+  ResourceLoader resource_loader_;
+
   std::map<std::string, std::unique_ptr<base::OneShotTimer>>
       notification_timers_;
 
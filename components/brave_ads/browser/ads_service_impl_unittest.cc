@@ -4,11 +4,16 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <string>
 
 #include "base/containers/flat_map.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "bat/ads/ads.h"
+#include "bat/ads/ads_client.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service_impl.h"
 #include "brave/components/brave_ads/browser/test_util.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
 #include "brave/components/brave_rewards/common/pref_names.h"
@@ -277,3 +282,16 @@ class AdsServiceTest : public testing::Test {
   base::ScopedTempDir temp_dir_;
   MockRewardsService* rewards_service_;
 };
+
+TEST_F(AdsServiceTest, LoadSchemaResource) {
+  ads::AdsClient* ads_client =
+      static_cast<brave_ads::AdsServiceImpl*>(ads_service());
+
+  const std::string schema =
+      ads_client->LoadResourceForId(ads::g_catalog_schema_resource_id);
+  EXPECT_TRUE(base::JSONReader::Read(schema));
+
+  // The decompressed schema is kept, so later loads return the same value
+  EXPECT_EQ(schema,
+            ads_client->LoadResourceForId(ads::g_catalog_schema_resource_id));
+}
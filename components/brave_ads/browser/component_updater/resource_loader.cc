@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/component_updater/resource_loader.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
+
+namespace brave_ads {
+
+namespace {
+
+std::string LoadOnTaskRunner(const base::FilePath& path) {
+  std::string value;
+  if (!base::ReadFileToString(path, &value)) {
+    return "";
+  }
+
+  return value;
+}
+
+}  // namespace
+
+ResourceLoader::ResourceLoader() = default;
+
+ResourceLoader::~ResourceLoader() = default;
+
+void ResourceLoader::Load(const std::string& id,
+                          const base::FilePath& path,
+                          LoadCallback callback) {
+  auto iter = task_runners_.find(id);
+  if (iter == task_runners_.end()) {
+    // Resources are read-only component files, so are not read on the ads
+    // service's file sequence behind database transactions
+    iter = task_runners_
+               .emplace(id, base::ThreadPool::CreateSequencedTaskRunner(
+                                {base::MayBlock(),
+                                 base::TaskPriority::USER_VISIBLE,
+                                 base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}))
+               .first;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      iter->second.get(), FROM_HERE, base::BindOnce(&LoadOnTaskRunner, path),
+      std::move(callback));
+}
+
+}  // namespace brave_ads
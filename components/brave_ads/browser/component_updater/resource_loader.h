@@ -0,0 +1,45 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_COMPONENT_UPDATER_RESOURCE_LOADER_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_COMPONENT_UPDATER_RESOURCE_LOADER_H_
+
+#include <map>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/sequenced_task_runner.h"
+
+namespace brave_ads {
+
+// Reads resource files on the thread pool. Different resources are read in
+// parallel, but each resource has its own sequence so that reads of the same
+// resource reply in the order they were requested. Otherwise a slow read from
+// a previous component version could reply after, and replace, a newer one
+class ResourceLoader {
+ public:
+  using LoadCallback = base::OnceCallback<void(const std::string& value)>;
+
+  ResourceLoader();
+  ~ResourceLoader();
+
+  ResourceLoader(const ResourceLoader&) = delete;
+  ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+  // |callback| is run with an empty string if the file is missing or empty
+  void Load(const std::string& id,
+            const base::FilePath& path,
+            LoadCallback callback);
+
+ private:
+  std::map<std::string, scoped_refptr<base::SequencedTaskRunner>>
+      task_runners_;
+};
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_COMPONENT_UPDATER_RESOURCE_LOADER_H_
@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/component_updater/resource_loader.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=ResourceLoaderTest.*
+
+namespace brave_ads {
+
+namespace {
+
+void AppendValue(std::vector<std::string>* values, const std::string& value) {
+  values->push_back(value);
+}
+
+}  // namespace
+
+class ResourceLoaderTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteResource(const std::string& name,
+                               const std::string& value) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, value));
+    return path;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  ResourceLoader resource_loader_;
+};
+
+TEST_F(ResourceLoaderTest, LoadResource) {
+  const base::FilePath path = WriteResource("resource", "value");
+
+  std::vector<std::string> values;
+  resource_loader_.Load("id", path, base::BindOnce(&AppendValue, &values));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(std::vector<std::string>({"value"}), values);
+}
+
+TEST_F(ResourceLoaderTest, LoadMissingResource) {
+  const base::FilePath path = temp_dir_.GetPath().AppendASCII("missing");
+
+  std::vector<std::string> values;
+  resource_loader_.Load("id", path, base::BindOnce(&AppendValue, &values));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(std::vector<std::string>({""}), values);
+}
+
+TEST_F(ResourceLoaderTest, ReplyInRequestOrderForSameResource) {
+  // A large file from the previous component version is requested before a
+  // small file from the new one, so would be read last if not sequenced
+  const base::FilePath old_path =
+      WriteResource("old", std::string(4 * 1024 * 1024, 'a'));
+  const base::FilePath new_path = WriteResource("new", "b");
+
+  std::vector<std::string> values;
+  for (int i = 0; i < 10; i++) {
+    resource_loader_.Load("id", old_path,
+                          base::BindOnce(&AppendValue, &values));
+    resource_loader_.Load("id", new_path,
+                          base::BindOnce(&AppendValue, &values));
+  }
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(20u, values.size());
+  for (size_t i = 0; i < values.size(); i += 2) {
+    EXPECT_EQ('a', values.at(i).front());
+    EXPECT_EQ("b", values.at(i + 1));
+  }
+}
+
+}  // namespace brave_ads
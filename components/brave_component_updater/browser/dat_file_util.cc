@@ -34,6 +34,24 @@ void GetDATFileData(const base::FilePath& file_path,
   }
 }
 
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path) {
+  auto mapping = std::make_unique<base::MemoryMappedFile>();
+  if (!mapping->Initialize(file_path) || mapping->length() == 0) {
+    LOG(ERROR) << "MapDATFile: "
+               << "the dat file is not found or corrupted "
+               << file_path;
+    return nullptr;
+  }
+
+  return mapping;
+}
+
+base::span<const uint8_t> GetDATFileSpan(
+    const base::MemoryMappedFile& mapping) {
+  return base::make_span(mapping.data(), mapping.length());
+}
+
 std::string GetDATFileAsString(const base::FilePath& file_path) {
   std::string contents;
   bool success = base::ReadFileToString(file_path, &contents);
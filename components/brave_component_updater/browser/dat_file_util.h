@@ -6,42 +6,80 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
 using DATFileDataBuffer = std::vector<unsigned char>;
 
+// Maps |file_path| read-only into memory. Returns nullptr if the file is
+// missing, empty or cannot be mapped. Unmapping may block, so the mapping must
+// be destroyed on a sequence that allows blocking.
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
+
+// Returns a read-only view of |mapping| that is valid for its lifetime.
+base::span<const uint8_t> GetDATFileSpan(
+    const base::MemoryMappedFile& mapping);
+
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
 
-template<typename T>
-using LoadDATFileDataResult =
-    std::pair<std::unique_ptr<T>, brave_component_updater::DATFileDataBuffer>;
+template <typename T>
+bool DeserializeDATFileData(const base::MemoryMappedFile& mapping, T* client) {
+  const base::span<const uint8_t> data = GetDATFileSpan(mapping);
+  return client->deserialize(reinterpret_cast<const char*>(data.data()),
+                             data.size());
+}
+
+// Deserializes |T| straight from a read-only mapping of |dat_file_path|, for
+// consumers that copy what they need out of the data. The mapping is released
+// before returning. Returns nullptr if the file cannot be mapped or
+// deserialized.
+template <typename T>
+std::unique_ptr<T> LoadDATFileData(const base::FilePath& dat_file_path) {
+  std::unique_ptr<base::MemoryMappedFile> mapping = MapDATFile(dat_file_path);
+  if (!mapping)
+    return nullptr;
+
+  auto client = std::make_unique<T>();
+  if (!DeserializeDATFileData(*mapping, client.get()))
+    return nullptr;
 
-template<typename T>
-LoadDATFileDataResult<T> LoadDATFileData(
-    const base::FilePath& dat_file_path) {
+  return client;
+}
+
+template <typename T>
+using ReadDATFileDataResult = std::pair<std::unique_ptr<T>, DATFileDataBuffer>;
+
+// Reads |dat_file_path| into a heap buffer and deserializes |T| from it, for
+// consumers that take a mutable buffer and keep referencing it after
+// deserializing. The buffer is handed back and must outlive the client. Unlike
+// a mapping, it doesn't hold the file open, so the component updater can
+// still remove old versions. The client is null if the file cannot be read or
+// deserialized.
+template <typename T>
+ReadDATFileDataResult<T> ReadDATFileData(const base::FilePath& dat_file_path) {
   DATFileDataBuffer buffer;
   GetDATFileData(dat_file_path, &buffer);
-  std::unique_ptr<T> client;
-  client = std::make_unique<T>();
+  std::unique_ptr<T> client = std::make_unique<T>();
   if (buffer.empty() ||
       !client->deserialize(reinterpret_cast<char*>(&buffer.front()),
-          buffer.size()))
+                           buffer.size()))
     client.reset();
 
-  return LoadDATFileDataResult<T>(
-      std::move(client), std::move(buffer));
+  return ReadDATFileDataResult<T>(std::move(client), std::move(buffer));
 }
 
-
 }  // namespace brave_component_updater
 
 #endif  // BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
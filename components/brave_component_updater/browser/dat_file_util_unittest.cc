@@ -0,0 +1,106 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_component_updater {
+
+namespace {
+
+constexpr char kDATFileContents[] = "dat file contents";
+
+class FakeDATClient {
+ public:
+  bool deserialize(const char* data, size_t data_size) {
+    data_ = data;
+    contents_ = std::string(data, data_size);
+    return contents_ == kDATFileContents;
+  }
+
+  const char* data() const { return data_; }
+  const std::string& contents() const { return contents_; }
+
+ private:
+  const char* data_ = nullptr;
+  std::string contents_;
+};
+
+}  // namespace
+
+class DATFileUtilTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  base::FilePath WriteDATFile(const std::string& contents) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII("test.dat");
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(DATFileUtilTest, MapMissingFile) {
+  EXPECT_FALSE(MapDATFile(temp_dir_.GetPath().AppendASCII("missing.dat")));
+}
+
+TEST_F(DATFileUtilTest, MapEmptyFile) {
+  EXPECT_FALSE(MapDATFile(WriteDATFile("")));
+}
+
+TEST_F(DATFileUtilTest, MapFile) {
+  std::unique_ptr<base::MemoryMappedFile> mapping =
+      MapDATFile(WriteDATFile(kDATFileContents));
+  ASSERT_TRUE(mapping);
+
+  const base::span<const uint8_t> data = GetDATFileSpan(*mapping);
+  EXPECT_EQ(kDATFileContents, std::string(data.begin(), data.end()));
+}
+
+TEST_F(DATFileUtilTest, LoadDATFileData) {
+  std::unique_ptr<FakeDATClient> client =
+      LoadDATFileData<FakeDATClient>(WriteDATFile(kDATFileContents));
+  ASSERT_TRUE(client);
+  EXPECT_EQ(kDATFileContents, client->contents());
+}
+
+TEST_F(DATFileUtilTest, LoadDATFileDataFailsToDeserialize) {
+  EXPECT_FALSE(LoadDATFileData<FakeDATClient>(WriteDATFile("corrupted")));
+}
+
+TEST_F(DATFileUtilTest, ReadDATFileDataDeserializesFromBuffer) {
+  ReadDATFileDataResult<FakeDATClient> result =
+      ReadDATFileData<FakeDATClient>(WriteDATFile(kDATFileContents));
+  ASSERT_TRUE(result.first);
+
+  // The client must be able to keep referencing the returned buffer.
+  EXPECT_EQ(reinterpret_cast<const char*>(result.second.data()),
+            result.first->data());
+  EXPECT_EQ(kDATFileContents, result.first->contents());
+}
+
+TEST_F(DATFileUtilTest, ReadDATFileDataFailsToDeserialize) {
+  ReadDATFileDataResult<FakeDATClient> result =
+      ReadDATFileData<FakeDATClient>(WriteDATFile("corrupted"));
+  EXPECT_FALSE(result.first);
+}
+
+TEST_F(DATFileUtilTest, ReadMissingDATFileData) {
+  ReadDATFileDataResult<FakeDATClient> result = ReadDATFileData<FakeDATClient>(
+      temp_dir_.GetPath().AppendASCII("missing.dat"));
+  EXPECT_FALSE(result.first);
+  EXPECT_TRUE(result.second.empty());
+}
+
+}  // namespace brave_component_updater
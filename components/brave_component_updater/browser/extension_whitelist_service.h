@@ -32,7 +32,7 @@ namespace brave_component_updater {
 class ExtensionWhitelistService : public LocalDataFilesObserver {
  public:
   using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<ExtensionWhitelistParser>;
+      brave_component_updater::ReadDATFileDataResult<ExtensionWhitelistParser>;
 
   explicit ExtensionWhitelistService(
       LocalDataFilesService* local_data_files_service,
@@ -57,6 +57,8 @@ class ExtensionWhitelistService : public LocalDataFilesObserver {
 
   SEQUENCE_CHECKER(sequence_checker_);
   std::unique_ptr<ExtensionWhitelistParser> extension_whitelist_client_;
+  // The parser references the DAT file data in place, so the buffer is kept
+  // alive for as long as |extension_whitelist_client_| uses it.
   brave_component_updater::DATFileDataBuffer buffer_;
   std::vector<std::string> whitelist_;
   base::WeakPtrFactory<ExtensionWhitelistService> weak_factory_;
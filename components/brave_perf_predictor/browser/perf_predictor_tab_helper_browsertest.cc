@@ -3,10 +3,13 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "base/auto_reset.h"
 #include "base/path_service.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
@@ -41,7 +44,10 @@ uint64_t getProfileAdsBlocked(Browser* browser) {
 
 class PerfPredictorTabHelperTest : public InProcessBrowserTest {
  public:
-  PerfPredictorTabHelperTest() {}
+  PerfPredictorTabHelperTest()
+      : blocked_counts_flush_delay_override_(
+            brave_shields::BraveShieldsWebContentsObserver::
+                SetBlockedCountsFlushDelayForTesting(base::TimeDelta())) {}
 
   void SetUpOnMainThread() override {
     InProcessBrowserTest::SetUpOnMainThread();
@@ -69,6 +75,9 @@ class PerfPredictorTabHelperTest : public InProcessBrowserTest {
     content::SetupCrossSiteRedirector(embedded_test_server());
     ASSERT_TRUE(embedded_test_server()->Start());
   }
+
+ private:
+  base::AutoReset<base::TimeDelta> blocked_counts_flush_delay_override_;
 };
 
 IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, NoBlockNoSavings) {
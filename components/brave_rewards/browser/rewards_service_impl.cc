@@ -17,6 +17,7 @@
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/containers/flat_map.h"
 #include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
@@ -35,6 +36,7 @@
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "bat/ads/pref_names.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/ledger_database.h"
@@ -279,6 +281,19 @@ std::string GetPrefPath(const std::string& name) {
   return base::StringPrintf("%s.%s", pref_prefix, name.c_str());
 }
 
+void AddLedgerState(base::flat_map<std::string, base::Value>* state,
+                    const std::string& path,
+                    const base::Value& value) {
+  DCHECK(state);
+
+  const std::string prefix = GetPrefPath("");
+  if (!base::StartsWith(path, prefix)) {
+    return;
+  }
+
+  state->insert({path.substr(prefix.length()), value.Clone()});
+}
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -451,8 +466,12 @@ void RewardsServiceImpl::StartLedgerProcessIfNecessary() {
     return;
   }
 
+#if defined(OS_ANDROID)
+  // The ledger process is sandboxed on Android and cannot open the database,
+  // so its transactions are run here instead
   ledger_database_.reset(
       ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
+#endif
 
   BLOG(1, "Starting ledger process");
 
@@ -489,6 +508,10 @@ void RewardsServiceImpl::StartLedgerProcessIfNecessary() {
     }
   }
 
+#if !defined(OS_ANDROID)
+  bat_ledger_service_->SetDatabasePath(publisher_info_db_path_);
+#endif
+
   bat_ledger_service_->Create(
       bat_ledger_client_receiver_.BindNewEndpointAndPassRemote(),
       bat_ledger_.BindNewEndpointAndPassReceiver(),
@@ -503,8 +526,12 @@ void RewardsServiceImpl::OnLedgerCreated() {
 
   PrepareLedgerEnvForTesting();
 
+  base::flat_map<std::string, base::Value> state;
+  profile_->GetPrefs()->IteratePreferenceValues(
+      base::BindRepeating(&AddLedgerState, &state));
+
   bat_ledger_->Initialize(
-      false,
+      false, std::move(state),
       base::BindOnce(&RewardsServiceImpl::OnLedgerInitialized, AsWeakPtr()));
 }
 
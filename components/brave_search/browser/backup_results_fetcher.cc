@@ -0,0 +1,153 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_search/browser/backup_results_fetcher.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/time/default_tick_clock.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/storage_partition.h"
+#include "net/base/load_flags.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+
+namespace {
+
+net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
+  return net::DefineNetworkTrafficAnnotation("brave_search_host", R"(
+      semantics {
+        sender: "Brave Search Host Controller"
+        description:
+          "This controller is used as a backup search "
+          "provider for users that have opted into this feature."
+        trigger:
+          "Triggered by Brave search if a user has opted in."
+        data:
+          "Local backup provider results."
+        destination: WEBSITE
+      }
+      policy {
+        cookies_allowed: NO
+        setting:
+          "You can enable or disable this feature on chrome://flags."
+        policy_exception_justification:
+          "Not implemented."
+      }
+    )");
+}
+
+const char kBackupResultsFetcherKey[] = "brave_search_backup_results_fetcher";
+const unsigned int kRetriesCountOnNetworkChange = 1;
+// Several tabs running the same query usually do so within seconds.
+constexpr base::TimeDelta kCachedResponseTTL = base::TimeDelta::FromSeconds(30);
+const size_t kMaxCachedResponses = 10;
+
+}  // namespace
+
+namespace brave_search {
+
+BackupResultsFetcher::PendingRequest::PendingRequest() = default;
+BackupResultsFetcher::PendingRequest::PendingRequest(PendingRequest&&) =
+    default;
+BackupResultsFetcher::PendingRequest&
+BackupResultsFetcher::PendingRequest::operator=(PendingRequest&&) = default;
+BackupResultsFetcher::PendingRequest::~PendingRequest() = default;
+
+BackupResultsFetcher::BackupResultsFetcher(
+    scoped_refptr<network::SharedURLLoaderFactory> factory)
+    : shared_url_loader_factory_(std::move(factory)),
+      tick_clock_(base::DefaultTickClock::GetInstance()),
+      cached_responses_(kMaxCachedResponses) {}
+
+BackupResultsFetcher::~BackupResultsFetcher() = default;
+
+// static
+BackupResultsFetcher* BackupResultsFetcher::GetForBrowserContext(
+    content::BrowserContext* context) {
+  BackupResultsFetcher* fetcher = static_cast<BackupResultsFetcher*>(
+      context->GetUserData(kBackupResultsFetcherKey));
+  if (!fetcher) {
+    // Object cleanup is handled by SupportsUserData.
+    context->SetUserData(
+        kBackupResultsFetcherKey,
+        std::make_unique<BackupResultsFetcher>(
+            content::BrowserContext::GetDefaultStoragePartition(context)
+                ->GetURLLoaderFactoryForBrowserProcess()));
+    fetcher = static_cast<BackupResultsFetcher*>(
+        context->GetUserData(kBackupResultsFetcherKey));
+  }
+  return fetcher;
+}
+
+void BackupResultsFetcher::Fetch(const GURL& url,
+                                 const std::string& geo,
+                                 FetchCallback callback) {
+  RequestKey key(url, geo);
+
+  auto cached = cached_responses_.Get(key);
+  if (cached != cached_responses_.end()) {
+    if (tick_clock_->NowTicks() < cached->second.expiration_time) {
+      std::move(callback).Run(cached->second.body);
+      return;
+    }
+    cached_responses_.Erase(cached);
+  }
+
+  auto pending = pending_requests_.find(key);
+  if (pending != pending_requests_.end()) {
+    pending->second.callbacks.push_back(std::move(callback));
+    return;
+  }
+
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = url;
+  // Responses are only kept in memory, search queries never reach the disk
+  // cache.
+  request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE;
+  request->credentials_mode = network::mojom::CredentialsMode::kOmit;
+  request->load_flags |= net::LOAD_DO_NOT_SAVE_COOKIES;
+  request->method = "GET";
+  request->headers.SetHeaderIfMissing("x-geo", geo);
+
+  PendingRequest& pending_request = pending_requests_[key];
+  pending_request.callbacks.push_back(std::move(callback));
+  pending_request.url_loader = network::SimpleURLLoader::Create(
+      std::move(request), GetNetworkTrafficAnnotationTag());
+  pending_request.url_loader->SetRetryOptions(
+      kRetriesCountOnNetworkChange,
+      network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
+  pending_request.url_loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      shared_url_loader_factory_.get(),
+      base::BindOnce(&BackupResultsFetcher::OnURLLoaderComplete,
+                     weak_factory_.GetWeakPtr(), key));
+}
+
+void BackupResultsFetcher::OnURLLoaderComplete(
+    const RequestKey& key,
+    std::unique_ptr<std::string> response_body) {
+  auto pending = pending_requests_.find(key);
+  DCHECK(pending != pending_requests_.end());
+  std::vector<FetchCallback> callbacks = std::move(pending->second.callbacks);
+  pending_requests_.erase(pending);
+
+  std::string body;
+  if (response_body) {
+    body = std::move(*response_body);
+  }
+
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(body);
+  }
+
+  if (response_body) {
+    cached_responses_.Put(
+        key, CachedResponse{std::move(body),
+                            tick_clock_->NowTicks() + kCachedResponseTTL});
+  }
+}
+
+}  // namespace brave_search
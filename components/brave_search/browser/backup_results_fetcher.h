@@ -0,0 +1,96 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BACKUP_RESULTS_FETCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BACKUP_RESULTS_FETCHER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace base {
+class TickClock;
+}  // namespace base
+
+namespace content {
+class BrowserContext;
+}  // namespace content
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace brave_search {
+
+// Fetches backup search results on behalf of all the BraveSearchHost
+// instances of a browser context. Identical requests that are in flight are
+// coalesced into a single network request, and successful responses are
+// served from memory for a short time.
+class BackupResultsFetcher : public base::SupportsUserData::Data {
+ public:
+  using FetchCallback = base::OnceCallback<void(const std::string&)>;
+
+  explicit BackupResultsFetcher(
+      scoped_refptr<network::SharedURLLoaderFactory> factory);
+  ~BackupResultsFetcher() override;
+  BackupResultsFetcher(const BackupResultsFetcher&) = delete;
+  BackupResultsFetcher& operator=(const BackupResultsFetcher&) = delete;
+
+  static BackupResultsFetcher* GetForBrowserContext(
+      content::BrowserContext* context);
+
+  // Runs |callback| with the response body, or an empty string on failure.
+  // |geo| is sent as the x-geo header and is part of the request identity.
+  void Fetch(const GURL& url, const std::string& geo, FetchCallback callback);
+
+  base::WeakPtr<BackupResultsFetcher> AsWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+  void SetTickClockForTesting(const base::TickClock* tick_clock) {
+    tick_clock_ = tick_clock;
+  }
+
+ private:
+  using RequestKey = std::pair<GURL, std::string>;
+
+  struct PendingRequest {
+    PendingRequest();
+    PendingRequest(PendingRequest&&);
+    PendingRequest& operator=(PendingRequest&&);
+    ~PendingRequest();
+
+    std::unique_ptr<network::SimpleURLLoader> url_loader;
+    std::vector<FetchCallback> callbacks;
+  };
+
+  struct CachedResponse {
+    std::string body;
+    base::TimeTicks expiration_time;
+  };
+
+  void OnURLLoaderComplete(const RequestKey& key,
+                           std::unique_ptr<std::string> response_body);
+
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  const base::TickClock* tick_clock_;
+  std::map<RequestKey, PendingRequest> pending_requests_;
+  base::MRUCache<RequestKey, CachedResponse> cached_responses_;
+  base::WeakPtrFactory<BackupResultsFetcher> weak_factory_{this};
+};
+
+}  // namespace brave_search
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BACKUP_RESULTS_FETCHER_H_
@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_search/browser/backup_results_fetcher.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "services/network/test/test_shared_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_search {
+
+class BackupResultsFetcherTest : public testing::Test {
+ public:
+  BackupResultsFetcherTest()
+      : task_environment_(content::BrowserTaskEnvironment::IO_MAINLOOP),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::TestSharedURLLoaderFactory>()) {}
+
+  void SetUp() override {
+    test_server_.RegisterRequestHandler(base::BindRepeating(
+        &BackupResultsFetcherTest::HandleRequest, base::Unretained(this)));
+    ASSERT_TRUE(test_server_.Start());
+
+    fetcher_ =
+        std::make_unique<BackupResultsFetcher>(shared_url_loader_factory_);
+    fetcher_->SetTickClockForTesting(&tick_clock_);
+  }
+
+ protected:
+  std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
+      const net::test_server::HttpRequest& request) {
+    ++request_count_;
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    if (request.GetURL().path_piece() != "/search") {
+      http_response->set_code(net::HTTP_NOT_FOUND);
+      return http_response;
+    }
+    http_response->set_code(net::HTTP_OK);
+    http_response->set_content_type("text/html");
+    http_response->set_content("results for " + request.GetURL().query() +
+                               " at " + request.headers.at("x-geo"));
+    return http_response;
+  }
+
+  // Issues |count| identical fetches at once and waits for all of them.
+  void FetchAndWait(const GURL& url,
+                    const std::string& geo,
+                    int count,
+                    const std::string& expected_body) {
+    base::RunLoop run_loop;
+    int pending = count;
+    for (int i = 0; i < count; ++i) {
+      fetcher_->Fetch(url, geo,
+                      base::BindLambdaForTesting([&](const std::string& body) {
+                        EXPECT_EQ(expected_body, body);
+                        if (--pending == 0) {
+                          run_loop.Quit();
+                        }
+                      }));
+    }
+    run_loop.Run();
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  net::EmbeddedTestServer test_server_;
+  std::atomic<int> request_count_{0};
+  scoped_refptr<network::TestSharedURLLoaderFactory> shared_url_loader_factory_;
+  base::SimpleTestTickClock tick_clock_;
+  std::unique_ptr<BackupResultsFetcher> fetcher_;
+};
+
+TEST_F(BackupResultsFetcherTest, CoalescesIdenticalRequests) {
+  const GURL url = test_server_.GetURL("/search?q=test");
+  FetchAndWait(url, "32,32", 5, "results for q=test at 32,32");
+  EXPECT_EQ(1, request_count_);
+
+  // A different geo header is a different request.
+  FetchAndWait(url, "64,64", 3, "results for q=test at 64,64");
+  EXPECT_EQ(2, request_count_);
+}
+
+TEST_F(BackupResultsFetcherTest, CachedResponsesExpire) {
+  const GURL url = test_server_.GetURL("/search?q=test");
+  FetchAndWait(url, "32,32", 1, "results for q=test at 32,32");
+  EXPECT_EQ(1, request_count_);
+
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(10));
+  FetchAndWait(url, "32,32", 1, "results for q=test at 32,32");
+  EXPECT_EQ(1, request_count_);
+
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(30));
+  FetchAndWait(url, "32,32", 1, "results for q=test at 32,32");
+  EXPECT_EQ(2, request_count_);
+}
+
+TEST_F(BackupResultsFetcherTest, FailedResponsesAreNotCached) {
+  const GURL url = test_server_.GetURL("/missing?q=test");
+  FetchAndWait(url, "32,32", 2, "");
+  EXPECT_EQ(1, request_count_);
+
+  FetchAndWait(url, "32,32", 1, "");
+  EXPECT_EQ(2, request_count_);
+}
+
+}  // namespace brave_search
@@ -6,28 +6,21 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_HOST_H_
 #define BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_HOST_H_
 
-#include <list>
-#include <map>
-#include <memory>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_search/common/brave_search.mojom.h"
 #include "url/gurl.h"
 
-namespace network {
-class SharedURLLoaderFactory;
-class SimpleURLLoader;
-}  // namespace network
-
 namespace brave_search {
 
+class BackupResultsFetcher;
+
 class BraveSearchHost final : public brave_search::mojom::BraveSearchFallback {
  public:
   BraveSearchHost(const BraveSearchHost&) = delete;
   BraveSearchHost& operator=(const BraveSearchHost&) = delete;
-  explicit BraveSearchHost(
-      scoped_refptr<network::SharedURLLoaderFactory> factory);
+  explicit BraveSearchHost(base::WeakPtr<BackupResultsFetcher> fetcher);
   ~BraveSearchHost() override;
 
   void FetchBackupResults(const std::string& query_string,
@@ -46,19 +39,8 @@ class BraveSearchHost final : public brave_search::mojom::BraveSearchFallback {
   static void SetBackupProviderForTest(const GURL&);
 
  private:
-  using SimpleURLLoaderList =
-      std::list<std::unique_ptr<network::SimpleURLLoader>>;
-  using URLRequestCallback =
-      base::OnceCallback<void(const int,
-                              const std::string&,
-                              const std::map<std::string, std::string>&)>;
-
-  void OnURLLoaderComplete(SimpleURLLoaderList::iterator iter,
-                           BraveSearchHost::FetchBackupResultsCallback callback,
-                           const std::unique_ptr<std::string> response_body);
-  SimpleURLLoaderList url_loaders_;
-  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
-  base::WeakPtrFactory<BraveSearchHost> weak_factory_;
+  // Shared by all the hosts of a browser context.
+  base::WeakPtr<BackupResultsFetcher> fetcher_;
 };
 
 }  // namespace brave_search
@@ -119,6 +119,7 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
     const std::string& tab_host,
+    bool is_third_party,
     bool* did_match_rule,
     bool* did_match_exception,
     bool* did_match_important,
@@ -127,8 +128,8 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
 
   for (const auto& regional_service : regional_services_) {
     regional_service.second->ShouldStartRequest(
-        url, resource_type, tab_host, did_match_rule, did_match_exception,
-        did_match_important, mock_data_url);
+        url, resource_type, tab_host, is_third_party, did_match_rule,
+        did_match_exception, did_match_important, mock_data_url);
     if (did_match_important && *did_match_important) {
       return;
     }
@@ -138,12 +139,14 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
 base::Optional<std::string> AdBlockRegionalServiceManager::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
-    const std::string& tab_host) {
+    const std::string& tab_host,
+    bool is_third_party) {
   base::Optional<std::string> csp_directives = base::nullopt;
 
   for (const auto& regional_service : regional_services_) {
     const auto directive =
-        regional_service.second->GetCspDirectives(url, resource_type, tab_host);
+        regional_service.second->GetCspDirectives(url, resource_type, tab_host,
+                                                  is_third_party);
     MergeCspDirectiveInto(directive, &csp_directives);
   }
 
@@ -50,6 +50,7 @@ class AdBlockRegionalServiceManager {
   void ShouldStartRequest(const GURL& url,
                           blink::mojom::ResourceType resource_type,
                           const std::string& tab_host,
+                          bool is_third_party,
                           bool* did_match_rule,
                           bool* did_match_exception,
                           bool* did_match_important,
@@ -57,7 +58,8 @@ class AdBlockRegionalServiceManager {
   base::Optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
-      const std::string& tab_host);
+      const std::string& tab_host,
+      bool is_third_party);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
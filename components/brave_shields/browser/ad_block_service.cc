@@ -66,42 +66,45 @@ void AdBlockService::ShouldStartRequest(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
     const std::string& tab_host,
+    bool is_third_party,
     bool* did_match_rule,
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
   AdBlockBaseService::ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
+      url, resource_type, tab_host, is_third_party, did_match_rule,
+      did_match_exception, did_match_important, mock_data_url);
   if (did_match_important && *did_match_important) {
     return;
   }
 
   regional_service_manager()->ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
+      url, resource_type, tab_host, is_third_party, did_match_rule,
+      did_match_exception, did_match_important, mock_data_url);
   if (did_match_important && *did_match_important) {
     return;
   }
 
   custom_filters_service()->ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
+      url, resource_type, tab_host, is_third_party, did_match_rule,
+      did_match_exception, did_match_important, mock_data_url);
 }
 
 base::Optional<std::string> AdBlockService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
-    const std::string& tab_host) {
+    const std::string& tab_host,
+    bool is_third_party) {
   auto csp_directives =
-      AdBlockBaseService::GetCspDirectives(url, resource_type, tab_host);
+      AdBlockBaseService::GetCspDirectives(url, resource_type, tab_host,
+                                           is_third_party);
 
   const auto regional_csp = regional_service_manager()->GetCspDirectives(
-      url, resource_type, tab_host);
+      url, resource_type, tab_host, is_third_party);
   MergeCspDirectiveInto(regional_csp, &csp_directives);
 
-  const auto custom_csp =
-      custom_filters_service()->GetCspDirectives(url, resource_type, tab_host);
+  const auto custom_csp = custom_filters_service()->GetCspDirectives(
+      url, resource_type, tab_host, is_third_party);
   MergeCspDirectiveInto(custom_csp, &csp_directives);
 
   return csp_directives;
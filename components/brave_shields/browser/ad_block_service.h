@@ -52,6 +52,7 @@ class AdBlockService : public AdBlockBaseService {
   void ShouldStartRequest(const GURL& url,
                           blink::mojom::ResourceType resource_type,
                           const std::string& tab_host,
+                          bool is_third_party,
                           bool* did_match_rule,
                           bool* did_match_exception,
                           bool* did_match_important,
@@ -59,7 +60,8 @@ class AdBlockService : public AdBlockBaseService {
   base::Optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
-      const std::string& tab_host);
+      const std::string& tab_host,
+      bool is_third_party);
   base::Optional<base::Value> UrlCosmeticResources(
       const std::string& url) override;
   base::Optional<base::Value> HiddenClassIdSelectors(
@@ -31,9 +31,12 @@ class BaseBraveShieldsService : public BraveComponent {
   ~BaseBraveShieldsService() override;
   bool Start();
   bool IsInitialized() const;
+  // |is_third_party| tells whether |url| is third-party to |tab_host|. It is
+  // computed once by the caller rather than by every engine that is queried.
   virtual void ShouldStartRequest(const GURL& url,
                                   blink::mojom::ResourceType resource_type,
                                   const std::string& tab_host,
+                                  bool is_third_party,
                                   bool* did_match_rule,
                                   bool* did_match_exception,
                                   bool* did_match_important,
@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/blocked_resource_counter.h"
+
+#include <functional>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/hash/hash.h"
+#include "components/prefs/pref_service.h"
+
+namespace brave_shields {
+
+BlockedResourceCounter::BlockedResourceCounter(
+    base::flat_map<std::string, std::string> pref_names)
+    : pref_names_(std::move(pref_names)) {}
+
+BlockedResourceCounter::~BlockedResourceCounter() = default;
+
+bool BlockedResourceCounter::Add(const std::string& block_type,
+                                 const std::string& subresource) {
+  const size_t subresource_hash = std::hash<std::string>()(subresource);
+  const size_t blocked_event_hash = base::HashInts(
+      std::hash<std::string>()(block_type), subresource_hash);
+  if (!seen_blocked_events_.insert(blocked_event_hash).second) {
+    return false;
+  }
+
+  // The profile counters only count each subresource once per page, whatever
+  // it was blocked as.
+  if (!seen_subresources_.insert(subresource_hash).second) {
+    return true;
+  }
+
+  const auto it = pref_names_.find(block_type);
+  if (it != pref_names_.end()) {
+    pending_counts_[it->second]++;
+  }
+
+  return true;
+}
+
+void BlockedResourceCounter::ScheduleFlush(PrefService* prefs,
+                                           base::TimeDelta delay) {
+  DCHECK(prefs);
+
+  if (!has_pending_counts()) {
+    return;
+  }
+
+  if (delay.is_zero()) {
+    Flush(prefs);
+    return;
+  }
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, delay,
+                       base::BindOnce(&BlockedResourceCounter::Flush,
+                                      base::Unretained(this), prefs));
+  }
+}
+
+void BlockedResourceCounter::Flush(PrefService* prefs) {
+  DCHECK(prefs);
+
+  flush_timer_.Stop();
+
+  for (const auto& pending_count : pending_counts_) {
+    const std::string& pref_name = pending_count.first;
+    prefs->SetUint64(pref_name,
+                     prefs->GetUint64(pref_name) + pending_count.second);
+  }
+
+  pending_counts_.clear();
+}
+
+void BlockedResourceCounter::ClearSeenSubresources() {
+  seen_subresources_.clear();
+  seen_blocked_events_.clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,68 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_RESOURCE_COUNTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_RESOURCE_COUNTER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_set>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+class PrefService;
+
+namespace brave_shields {
+
+// Keeps track of the resources blocked on a tab's current page and
+// accumulates the profile wide blocked counters so that they can be written
+// to prefs in batches instead of once per blocked request. Subresources are
+// remembered by hash to avoid holding a copy of every blocked URL.
+class BlockedResourceCounter {
+ public:
+  // |pref_names| maps the block types which are counted for the profile to
+  // the prefs holding their totals.
+  explicit BlockedResourceCounter(
+      base::flat_map<std::string, std::string> pref_names);
+  ~BlockedResourceCounter();
+
+  // Records that |subresource| was blocked as |block_type|. Returns false if
+  // it was already recorded as |block_type| on the current page, in which
+  // case there is nothing new to report.
+  bool Add(const std::string& block_type, const std::string& subresource);
+
+  // Flushes the pending counts to |prefs| once |delay| has passed, unless a
+  // flush is already scheduled. A zero delay flushes right away.
+  void ScheduleFlush(PrefService* prefs, base::TimeDelta delay);
+
+  // Adds the counts recorded since the last flush to the totals in |prefs|
+  // and cancels any scheduled flush. Each counter is written at most once per
+  // flush.
+  void Flush(PrefService* prefs);
+
+  // Forgets the subresources seen on the current page. Counts which have not
+  // been flushed yet are kept.
+  void ClearSeenSubresources();
+
+  bool has_pending_counts() const { return !pending_counts_.empty(); }
+
+ private:
+  const base::flat_map<std::string, std::string> pref_names_;
+  std::unordered_set<size_t> seen_subresources_;
+  std::unordered_set<size_t> seen_blocked_events_;
+  // Pending increments keyed by pref name.
+  base::flat_map<std::string, uint64_t> pending_counts_;
+  base::OneShotTimer flush_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockedResourceCounter);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_RESOURCE_COUNTER_H_
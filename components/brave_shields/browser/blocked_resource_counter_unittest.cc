@@ -0,0 +1,161 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/blocked_resource_counter.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kAdsBlocked[] = "test.ads_blocked";
+const char kJavascriptBlocked[] = "test.javascript_blocked";
+const char kHttpsUpgrades[] = "test.https_upgrades";
+
+}  // namespace
+
+class BlockedResourceCounterTest : public testing::Test {
+ public:
+  BlockedResourceCounterTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        counter_({{kAds, kAdsBlocked},
+                  {kHTTPUpgradableResources, kHttpsUpgrades},
+                  {kJavaScript, kJavascriptBlocked}}) {
+    auto* registry = prefs_.registry();
+    registry->RegisterUint64Pref(kAdsBlocked, 0);
+    registry->RegisterUint64Pref(kJavascriptBlocked, 0);
+    registry->RegisterUint64Pref(kHttpsUpgrades, 0);
+
+    pref_change_registrar_.Init(&prefs_);
+    for (const char* pref_name :
+         {kAdsBlocked, kJavascriptBlocked, kHttpsUpgrades}) {
+      pref_change_registrar_.Add(
+          pref_name,
+          base::BindRepeating(&BlockedResourceCounterTest::OnPrefChanged,
+                              base::Unretained(this)));
+    }
+  }
+
+ protected:
+  void OnPrefChanged() { pref_writes_++; }
+
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple prefs_;
+  PrefChangeRegistrar pref_change_registrar_;
+  int pref_writes_ = 0;
+  BlockedResourceCounter counter_;
+};
+
+TEST_F(BlockedResourceCounterTest, CountsEachSubresourceOncePerPage) {
+  EXPECT_TRUE(counter_.Add(kAds, "https://a.com/ad.js"));
+  EXPECT_FALSE(counter_.Add(kAds, "https://a.com/ad.js"));
+  EXPECT_TRUE(counter_.Add(kAds, "https://a.com/ad.png"));
+
+  counter_.Flush(&prefs_);
+
+  EXPECT_EQ(prefs_.GetUint64(kAdsBlocked), 2ULL);
+}
+
+TEST_F(BlockedResourceCounterTest, ReportsNewBlockTypeForSeenSubresource) {
+  EXPECT_TRUE(counter_.Add(kAds, "https://a.com/script.js"));
+  EXPECT_TRUE(counter_.Add(kJavaScript, "https://a.com/script.js"));
+
+  counter_.Flush(&prefs_);
+
+  EXPECT_EQ(prefs_.GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(prefs_.GetUint64(kJavascriptBlocked), 0ULL);
+}
+
+TEST_F(BlockedResourceCounterTest, ClearSeenSubresourcesKeepsPendingCounts) {
+  counter_.Add(kAds, "https://a.com/ad.js");
+  counter_.ClearSeenSubresources();
+
+  EXPECT_TRUE(counter_.Add(kAds, "https://a.com/ad.js"));
+  EXPECT_TRUE(counter_.has_pending_counts());
+
+  counter_.Flush(&prefs_);
+
+  EXPECT_EQ(prefs_.GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_FALSE(counter_.has_pending_counts());
+}
+
+TEST_F(BlockedResourceCounterTest, FlushWithoutPendingCountsDoesNotWrite) {
+  counter_.Add(kTrackers, "https://tracker.com/pixel.gif");
+
+  EXPECT_FALSE(counter_.has_pending_counts());
+
+  counter_.Flush(&prefs_);
+
+  EXPECT_EQ(pref_writes_, 0);
+}
+
+TEST_F(BlockedResourceCounterTest, ScheduledFlushWritesOnce) {
+  const base::TimeDelta kFlushDelay = base::TimeDelta::FromSeconds(1);
+  counter_.Add(kAds, "https://a.com/ad.js");
+  counter_.ScheduleFlush(&prefs_, kFlushDelay);
+  counter_.Add(kAds, "https://a.com/ad.png");
+  counter_.ScheduleFlush(&prefs_, kFlushDelay);
+
+  EXPECT_EQ(pref_writes_, 0);
+
+  task_environment_.FastForwardBy(kFlushDelay);
+
+  EXPECT_EQ(prefs_.GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(pref_writes_, 1);
+  EXPECT_FALSE(counter_.has_pending_counts());
+}
+
+TEST_F(BlockedResourceCounterTest, FlushCancelsScheduledFlush) {
+  const base::TimeDelta kFlushDelay = base::TimeDelta::FromSeconds(1);
+  counter_.Add(kAds, "https://a.com/ad.js");
+  counter_.ScheduleFlush(&prefs_, kFlushDelay);
+  counter_.Flush(&prefs_);
+
+  task_environment_.FastForwardBy(kFlushDelay);
+
+  EXPECT_EQ(prefs_.GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(pref_writes_, 1);
+}
+
+TEST_F(BlockedResourceCounterTest, BoundsPrefWritesForHeavyPageLoad) {
+  // Replay a page load blocking 5000 requests over 10 seconds, a fifth of
+  // which are repeats, scheduling a flush after each as the observer does.
+  const int kBlockedRequests = 5000;
+  const base::TimeDelta kRequestInterval =
+      base::TimeDelta::FromMilliseconds(2);
+  const base::TimeDelta kFlushDelay = base::TimeDelta::FromSeconds(1);
+  for (int i = 0; i < kBlockedRequests; i++) {
+    const std::string subresource =
+        "https://ads.example.com/" + base::NumberToString(i % 4000) + ".js";
+    if (counter_.Add(i % 10 == 0 ? kHTTPUpgradableResources : kAds,
+                     subresource)) {
+      counter_.ScheduleFlush(&prefs_, kFlushDelay);
+    }
+
+    task_environment_.FastForwardBy(kRequestInterval);
+  }
+
+  task_environment_.FastForwardBy(kFlushDelay);
+
+  EXPECT_EQ(prefs_.GetUint64(kAdsBlocked) + prefs_.GetUint64(kHttpsUpgrades),
+            4000ULL);
+  EXPECT_FALSE(counter_.has_pending_counts());
+  // At most one write per counter per flush, with a flush for each second of
+  // the page load and a last one once it is done.
+  EXPECT_LE(pref_writes_, 2 * 11);
+}
+
+}  // namespace brave_shields
@@ -41,8 +41,9 @@ bool ShouldBlockDomainOnTaskRunner(
   bool did_match_important = false;
   std::string mock_data_url;
   ad_block_service->ShouldStartRequest(
-      url, blink::mojom::ResourceType::kMainFrame, url.host(), &did_match_rule,
-      &did_match_exception, &did_match_important, &mock_data_url);
+      url, blink::mojom::ResourceType::kMainFrame, url.host(),
+      false /* is_third_party */, &did_match_rule, &did_match_exception,
+      &did_match_important, &mock_data_url);
   return (did_match_important || (did_match_rule && !did_match_exception));
 }
 
@@ -5,11 +5,20 @@
 
 #include "brave/components/brave_wallet/browser/keyring_controller.h"
 
+#include <utility>
+
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
+#include "components/os_crypt/os_crypt.h"
 #include "components/prefs/pref_service.h"
 #include "crypto/random.h"
 
@@ -17,25 +26,58 @@ namespace brave_wallet {
 namespace {
 const size_t kSaltSize = 32;
 const size_t kNonceSize = 12;
+const size_t kPbkdf2Iterations = 100000;
+const size_t kPbkdf2KeySize = 256;
+const char kDefaultKeyringHDPath[] = "m/44'/60'/0'/0";
+const char kAccountsSeparator[] = ",";
 
 static base::span<const uint8_t> ToSpan(base::StringPiece sp) {
   return base::as_bytes(base::make_span(sp));
 }
+
+std::unique_ptr<HDKeyring> CreateHDKeyringFromMnemonic(
+    const std::string& mnemonic,
+    size_t accounts_number) {
+  const std::unique_ptr<std::vector<uint8_t>> seed =
+      MnemonicToSeed(mnemonic, "");
+  if (!seed)
+    return nullptr;
+  auto keyring = std::make_unique<HDKeyring>();
+  keyring->ConstructRootHDKey(*seed, kDefaultKeyringHDPath);
+  if (accounts_number)
+    keyring->AddAccounts(accounts_number);
+
+  return keyring;
+}
 }  // namespace
 
-KeyringController::KeyringController(PrefService* prefs) : prefs_(prefs) {
+struct KeyringController::DerivedKeyring {
+  std::unique_ptr<PasswordEncryptor> encryptor;
+  std::vector<uint8_t> encrypted_mnemonic;
+  std::unique_ptr<HDKeyring> keyring;
+};
+
+KeyringController::KeyringController(PrefService* prefs)
+    : task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      prefs_(prefs) {
   DCHECK(prefs);
 }
 
 KeyringController::~KeyringController() {
   // Store the accounts number for keyring resume
-  if (!IsLocked() && default_keyring_)
+  if (!IsLocked() && default_keyring_) {
     prefs_->SetInteger(kBraveWalletDefaultKeyringAccountNum,
                        default_keyring_->GetAccounts().size());
+    CacheAccountsForDefaultKeyring();
+  }
 }
 
 HDKeyring* KeyringController::CreateDefaultKeyring(
     const std::string& password) {
+  keyring_generation_++;
+
   if (!CreateEncryptor(password))
     return nullptr;
 
@@ -80,6 +122,22 @@ HDKeyring* KeyringController::RestoreDefaultKeyring(
   return default_keyring_.get();
 }
 
+void KeyringController::CreateDefaultKeyring(
+    const std::string& password,
+    CreateDefaultKeyringCallback callback) {
+  CreateDefaultKeyringWithMnemonic(GenerateMnemonic(16), password,
+                                   std::move(callback));
+}
+
+void KeyringController::RestoreDefaultKeyring(
+    const std::string& mnemonic,
+    const std::string& password,
+    CreateDefaultKeyringCallback callback) {
+  Reset();
+
+  CreateDefaultKeyringWithMnemonic(mnemonic, password, std::move(callback));
+}
+
 std::string KeyringController::GetMnemonicForDefaultKeyring() {
   if (IsLocked()) {
     LOG(ERROR) << __func__ << ": Must Unlock controller first";
@@ -112,11 +170,15 @@ bool KeyringController::IsLocked() const {
 }
 
 void KeyringController::Lock() {
+  // Pending unlocks must not unlock the controller once it has been locked
+  keyring_generation_++;
+
   if (IsLocked() || !default_keyring_)
     return;
   // invalidate keyring and save account number
   prefs_->SetInteger(kBraveWalletDefaultKeyringAccountNum,
                      default_keyring_->GetAccounts().size());
+  CacheAccountsForDefaultKeyring();
   default_keyring_->ClearData();
 
   encryptor_.reset();
@@ -131,7 +193,70 @@ bool KeyringController::Unlock(const std::string& password) {
   return true;
 }
 
+void KeyringController::Unlock(const std::string& password,
+                               UnlockCallback callback) {
+  std::vector<uint8_t> salt;
+  std::vector<uint8_t> encrypted_mnemonic;
+  if (password.empty() ||
+      !GetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, &salt) ||
+      !GetPrefsInBytes(kBraveWalletEncryptedMnemonic, &encrypted_mnemonic)) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  const size_t accounts_number =
+      (size_t)prefs_->GetInteger(kBraveWalletDefaultKeyringAccountNum);
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&KeyringController::DeriveExistingDefaultKeyring,
+                     encrypted_mnemonic, password, salt, GetOrCreateNonce(),
+                     accounts_number),
+      base::BindOnce(&KeyringController::OnUnlock,
+                     weak_ptr_factory_.GetWeakPtr(), keyring_generation_,
+                     std::move(callback)));
+}
+
+void KeyringController::OnUnlock(
+    uint64_t generation,
+    UnlockCallback callback,
+    std::unique_ptr<DerivedKeyring> derived_keyring) {
+  // Unlike the blocking |Unlock| a wrong password leaves the controller as it
+  // was, so a failed unlock cannot lock it after a concurrent one succeeded
+  if (generation != keyring_generation_ || !derived_keyring) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  encryptor_ = std::move(derived_keyring->encryptor);
+  default_keyring_ = std::move(derived_keyring->keyring);
+  CacheAccountsForDefaultKeyring();
+
+  std::move(callback).Run(true);
+}
+
+std::vector<std::string>
+KeyringController::GetCachedAccountsForDefaultKeyring() {
+  std::vector<uint8_t> encrypted_accounts;
+  if (!GetPrefsInBytes(kBraveWalletDefaultKeyringEncryptedAccounts,
+                       &encrypted_accounts)) {
+    return std::vector<std::string>();
+  }
+
+  std::string accounts;
+  if (!OSCrypt::DecryptString(
+          std::string(encrypted_accounts.begin(), encrypted_accounts.end()),
+          &accounts)) {
+    return std::vector<std::string>();
+  }
+
+  return base::SplitString(accounts, kAccountsSeparator, base::TRIM_WHITESPACE,
+                           base::SPLIT_WANT_NONEMPTY);
+}
+
 void KeyringController::Reset() {
+  // Pending keyrings were derived from the mnemonic which is being cleared
+  keyring_generation_++;
+
   prefs_->ClearPref(kBraveWalletPasswordEncryptorSalt);
   prefs_->ClearPref(kBraveWalletPasswordEncryptorNonce);
   encryptor_.reset();
@@ -139,6 +264,7 @@ void KeyringController::Reset() {
   default_keyring_.reset();
   prefs_->ClearPref(kBraveWalletEncryptedMnemonic);
   prefs_->ClearPref(kBraveWalletDefaultKeyringAccountNum);
+  prefs_->ClearPref(kBraveWalletDefaultKeyringEncryptedAccounts);
 }
 
 bool KeyringController::GetPrefsInBytes(const std::string& path,
@@ -173,16 +299,20 @@ std::vector<uint8_t> KeyringController::GetOrCreateNonce() {
   return nonce;
 }
 
-bool KeyringController::CreateEncryptor(const std::string& password) {
-  if (password.empty())
-    return false;
+std::vector<uint8_t> KeyringController::GetOrCreateSalt() {
   std::vector<uint8_t> salt(kSaltSize);
   if (!GetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, &salt)) {
     crypto::RandBytes(salt);
     SetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, salt);
   }
+  return salt;
+}
+
+bool KeyringController::CreateEncryptor(const std::string& password) {
+  if (password.empty())
+    return false;
   encryptor_ = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, 100000, 256);
+      password, GetOrCreateSalt(), kPbkdf2Iterations, kPbkdf2KeySize);
   return encryptor_ != nullptr;
 }
 
@@ -197,16 +327,117 @@ bool KeyringController::CreateDefaultKeyringInternal(
   }
   SetPrefsInBytes(kBraveWalletEncryptedMnemonic, encrypted_mnemonic);
 
-  const std::unique_ptr<std::vector<uint8_t>> seed =
-      MnemonicToSeed(mnemonic, "");
-  if (!seed)
+  std::unique_ptr<HDKeyring> keyring = CreateHDKeyringFromMnemonic(mnemonic, 0);
+  if (!keyring)
     return false;
-  default_keyring_ = std::make_unique<HDKeyring>();
-  default_keyring_->ConstructRootHDKey(*seed, "m/44'/60'/0'/0");
+  default_keyring_ = std::move(keyring);
 
   return true;
 }
 
+void KeyringController::CacheAccountsForDefaultKeyring() {
+  DCHECK(default_keyring_);
+  const std::string accounts =
+      base::JoinString(default_keyring_->GetAccounts(), kAccountsSeparator);
+  std::string encrypted_accounts;
+  if (!OSCrypt::EncryptString(accounts, &encrypted_accounts)) {
+    LOG(ERROR) << __func__ << ": Could not encrypt accounts";
+    return;
+  }
+  SetPrefsInBytes(kBraveWalletDefaultKeyringEncryptedAccounts,
+                  ToSpan(encrypted_accounts));
+}
+
+// static
+std::unique_ptr<KeyringController::DerivedKeyring>
+KeyringController::DeriveNewDefaultKeyring(const std::string& mnemonic,
+                                           const std::string& password,
+                                           const std::vector<uint8_t>& salt,
+                                           const std::vector<uint8_t>& nonce) {
+  auto derived_keyring = std::make_unique<DerivedKeyring>();
+  derived_keyring->encryptor =
+      PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+          password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  if (!derived_keyring->encryptor ||
+      !derived_keyring->encryptor->Encrypt(
+          ToSpan(mnemonic), nonce, &derived_keyring->encrypted_mnemonic)) {
+    return nullptr;
+  }
+
+  derived_keyring->keyring = CreateHDKeyringFromMnemonic(mnemonic, 1);
+  if (!derived_keyring->keyring)
+    return nullptr;
+
+  return derived_keyring;
+}
+
+// static
+std::unique_ptr<KeyringController::DerivedKeyring>
+KeyringController::DeriveExistingDefaultKeyring(
+    const std::vector<uint8_t>& encrypted_mnemonic,
+    const std::string& password,
+    const std::vector<uint8_t>& salt,
+    const std::vector<uint8_t>& nonce,
+    size_t accounts_number) {
+  auto derived_keyring = std::make_unique<DerivedKeyring>();
+  derived_keyring->encryptor =
+      PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+          password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  std::vector<uint8_t> mnemonic;
+  if (!derived_keyring->encryptor ||
+      !derived_keyring->encryptor->Decrypt(encrypted_mnemonic, nonce,
+                                           &mnemonic)) {
+    return nullptr;
+  }
+
+  derived_keyring->keyring = CreateHDKeyringFromMnemonic(
+      std::string(mnemonic.begin(), mnemonic.end()), accounts_number);
+  SecureZeroData(mnemonic.data(), mnemonic.size());
+  if (!derived_keyring->keyring)
+    return nullptr;
+
+  return derived_keyring;
+}
+
+void KeyringController::CreateDefaultKeyringWithMnemonic(
+    const std::string& mnemonic,
+    const std::string& password,
+    CreateDefaultKeyringCallback callback) {
+  // Pending keyrings would otherwise replace this one
+  keyring_generation_++;
+
+  if (password.empty()) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&KeyringController::DeriveNewDefaultKeyring, mnemonic,
+                     password, GetOrCreateSalt(), GetOrCreateNonce()),
+      base::BindOnce(&KeyringController::OnCreateDefaultKeyring,
+                     weak_ptr_factory_.GetWeakPtr(), keyring_generation_,
+                     std::move(callback)));
+}
+
+void KeyringController::OnCreateDefaultKeyring(
+    uint64_t generation,
+    CreateDefaultKeyringCallback callback,
+    std::unique_ptr<DerivedKeyring> derived_keyring) {
+  if (generation != keyring_generation_ || !derived_keyring) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+
+  encryptor_ = std::move(derived_keyring->encryptor);
+  SetPrefsInBytes(kBraveWalletEncryptedMnemonic,
+                  derived_keyring->encrypted_mnemonic);
+  default_keyring_ = std::move(derived_keyring->keyring);
+  CacheAccountsForDefaultKeyring();
+
+  std::move(callback).Run(default_keyring_.get());
+}
+
 bool KeyringController::IsDefaultKeyringCreated() {
   return prefs_->HasPrefPath(kBraveWalletEncryptedMnemonic);
 }
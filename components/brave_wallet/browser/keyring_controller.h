@@ -10,11 +10,18 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wallet/browser/password_encryptor.h"
 
 class PrefService;
 
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
 namespace brave_wallet {
 
 class HDKeyring;
@@ -32,6 +39,9 @@ FORWARD_DECLARE_TEST(KeyringControllerUnitTest, Reset);
 // This class is not thread-safe and should have single owner
 class KeyringController {
  public:
+  using CreateDefaultKeyringCallback = base::OnceCallback<void(HDKeyring*)>;
+  using UnlockCallback = base::OnceCallback<void(bool)>;
+
   explicit KeyringController(PrefService* prefs);
   ~KeyringController();
 
@@ -41,15 +51,31 @@ class KeyringController {
   // Restore default keyring from backup seed phrase
   HDKeyring* RestoreDefaultKeyring(const std::string& mnemonic,
                                    const std::string& password);
+
+  // Same as above but the password key and the keyring with its first account
+  // are derived on a thread pool sequence, so they should be used instead on
+  // the UI thread. |callback| is run with nullptr if the controller was locked
+  // or reset in the meantime
+  void CreateDefaultKeyring(const std::string& password,
+                            CreateDefaultKeyringCallback callback);
+  void RestoreDefaultKeyring(const std::string& mnemonic,
+                             const std::string& password,
+                             CreateDefaultKeyringCallback callback);
   // Must unlock before using this API otherwise it will return empty string
   std::string GetMnemonicForDefaultKeyring();
   // Must unlock before using this API otherwise it will return nullptr
   HDKeyring* GetDefaultKeyring();
   bool IsDefaultKeyringCreated();
+  // Addresses of the default keyring accounts as of the last time it was
+  // unlocked, created or locked, which can be read while locked
+  std::vector<std::string> GetCachedAccountsForDefaultKeyring();
 
   bool IsLocked() const;
   void Lock();
   bool Unlock(const std::string& password);
+  // Same as above but derives the keyring on a thread pool sequence. |callback|
+  // is run with false if the controller was locked or reset in the meantime
+  void Unlock(const std::string& password, UnlockCallback callback);
 
   /* TODO(darkdh): For other keyrings support
   void DeleteKeyring(size_t index);
@@ -70,23 +96,57 @@ class KeyringController {
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, LockAndUnlock);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, Reset);
 
+  struct DerivedKeyring;
+
   bool GetPrefsInBytes(const std::string& path, std::vector<uint8_t>* bytes);
   void SetPrefsInBytes(const std::string& path,
                        base::span<const uint8_t> bytes);
   std::vector<uint8_t> GetOrCreateNonce();
+  std::vector<uint8_t> GetOrCreateSalt();
   bool CreateEncryptor(const std::string& password);
   bool CreateDefaultKeyringInternal(const std::string& mnemonic);
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeDefaultKeyring(const std::string& password);
+  void CacheAccountsForDefaultKeyring();
+
+  // These derive keys and so run on |task_runner_|
+  static std::unique_ptr<DerivedKeyring> DeriveNewDefaultKeyring(
+      const std::string& mnemonic,
+      const std::string& password,
+      const std::vector<uint8_t>& salt,
+      const std::vector<uint8_t>& nonce);
+  static std::unique_ptr<DerivedKeyring> DeriveExistingDefaultKeyring(
+      const std::vector<uint8_t>& encrypted_mnemonic,
+      const std::string& password,
+      const std::vector<uint8_t>& salt,
+      const std::vector<uint8_t>& nonce,
+      size_t accounts_number);
+
+  void CreateDefaultKeyringWithMnemonic(const std::string& mnemonic,
+                                        const std::string& password,
+                                        CreateDefaultKeyringCallback callback);
+  void OnCreateDefaultKeyring(uint64_t generation,
+                              CreateDefaultKeyringCallback callback,
+                              std::unique_ptr<DerivedKeyring> derived_keyring);
+  void OnUnlock(uint64_t generation,
+                UnlockCallback callback,
+                std::unique_ptr<DerivedKeyring> derived_keyring);
 
   std::unique_ptr<PasswordEncryptor> encryptor_;
   std::unique_ptr<HDKeyring> default_keyring_;
 
+  // Incremented whenever the keyring is locked, reset or replaced so that
+  // keyrings derived before then are discarded
+  uint64_t keyring_generation_ = 0;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
   // TODO(darkdh): For other keyrings support
   // std::vector<std::unique_ptr<HDKeyring>> keyrings_;
 
   PrefService* prefs_;
 
+  base::WeakPtrFactory<KeyringController> weak_ptr_factory_{this};
+
   KeyringController(const KeyringController&) = delete;
   KeyringController& operator=(const KeyringController&) = delete;
 };
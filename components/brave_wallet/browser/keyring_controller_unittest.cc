@@ -6,11 +6,13 @@
 #include "brave/components/brave_wallet/browser/keyring_controller.h"
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "chrome/browser/profiles/profile_manager.h"
 #include "chrome/test/base/testing_browser_process.h"
 #include "chrome/test/base/testing_profile_manager.h"
+#include "components/os_crypt/os_crypt_mocker.h"
 #include "content/public/test/browser_task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -24,16 +26,30 @@ class KeyringControllerUnitTest : public testing::Test {
 
  protected:
   void SetUp() override {
+    OSCryptMocker::SetUp();
     ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
     ASSERT_TRUE(testing_profile_manager_.SetUp(temp_dir_.GetPath()));
   }
 
+  void TearDown() override { OSCryptMocker::TearDown(); }
+
   PrefService* GetPrefs() {
     return ProfileManager::GetActiveUserProfile()->GetPrefs();
   }
 
- private:
+  void Unlock(KeyringController* controller,
+              const std::string& password,
+              bool* result) {
+    controller->Unlock(password, base::BindOnce(
+                                     [](bool* result, bool success) {
+                                       *result = success;
+                                     },
+                                     result));
+  }
+
   content::BrowserTaskEnvironment task_environment_;
+
+ private:
   TestingProfileManager testing_profile_manager_;
   base::ScopedTempDir temp_dir_;
 };
@@ -395,4 +411,166 @@ TEST_F(KeyringControllerUnitTest, Reset) {
   EXPECT_EQ(controller.encryptor_, nullptr);
 }
 
+TEST_F(KeyringControllerUnitTest, CreateDefaultKeyringAsync) {
+  KeyringController controller(GetPrefs());
+  HDKeyring* keyring = nullptr;
+  controller.CreateDefaultKeyring(
+      "brave", base::BindOnce(
+                   [](HDKeyring** keyring, HDKeyring* created_keyring) {
+                     *keyring = created_keyring;
+                   },
+                   &keyring));
+  // The key is derived on the thread pool
+  EXPECT_TRUE(controller.IsLocked());
+  EXPECT_FALSE(GetPrefs()->HasPrefPath(kBraveWalletEncryptedMnemonic));
+
+  task_environment_.RunUntilIdle();
+  ASSERT_NE(keyring, nullptr);
+  EXPECT_EQ(controller.GetDefaultKeyring(), keyring);
+  EXPECT_FALSE(controller.GetMnemonicForDefaultKeyring().empty());
+  EXPECT_EQ(keyring->GetAccounts().size(), 1u);
+  EXPECT_EQ(controller.GetCachedAccountsForDefaultKeyring(),
+            keyring->GetAccounts());
+
+  // empty password
+  keyring = nullptr;
+  controller.CreateDefaultKeyring(
+      "", base::BindOnce(
+              [](HDKeyring** keyring, HDKeyring* created_keyring) {
+                *keyring = created_keyring;
+              },
+              &keyring));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(keyring, nullptr);
+}
+
+TEST_F(KeyringControllerUnitTest, RestoreDefaultKeyringAsync) {
+  const std::string seed_phrase =
+      "divide cruise upon flag harsh carbon filter merit once advice bright "
+      "drive";
+  KeyringController controller(GetPrefs());
+  HDKeyring* keyring = nullptr;
+  controller.RestoreDefaultKeyring(
+      seed_phrase, "brave",
+      base::BindOnce(
+          [](HDKeyring** keyring, HDKeyring* restored_keyring) {
+            *keyring = restored_keyring;
+          },
+          &keyring));
+  task_environment_.RunUntilIdle();
+  ASSERT_NE(keyring, nullptr);
+  EXPECT_EQ(keyring->GetAddress(0),
+            "0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db");
+  EXPECT_EQ(controller.GetMnemonicForDefaultKeyring(), seed_phrase);
+}
+
+TEST_F(KeyringControllerUnitTest, UnlockAsync) {
+  std::vector<std::string> accounts;
+  {
+    KeyringController controller(GetPrefs());
+    HDKeyring* keyring = controller.CreateDefaultKeyring("brave");
+    keyring->AddAccounts(2);
+    accounts = keyring->GetAccounts();
+  }
+
+  KeyringController controller(GetPrefs());
+  bool result = true;
+  Unlock(&controller, "brave123", &result);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(result);
+  EXPECT_TRUE(controller.IsLocked());
+
+  Unlock(&controller, "", &result);
+  EXPECT_FALSE(result);
+
+  Unlock(&controller, "brave", &result);
+  // The key is derived on the thread pool
+  EXPECT_TRUE(controller.IsLocked());
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(result);
+  EXPECT_FALSE(controller.IsLocked());
+  ASSERT_NE(controller.GetDefaultKeyring(), nullptr);
+  EXPECT_EQ(controller.GetDefaultKeyring()->GetAccounts(), accounts);
+}
+
+TEST_F(KeyringControllerUnitTest, LockWhileUnlocking) {
+  KeyringController controller(GetPrefs());
+  ASSERT_NE(controller.CreateDefaultKeyring("brave"), nullptr);
+  controller.Lock();
+
+  bool result = true;
+  Unlock(&controller, "brave", &result);
+  controller.Lock();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(result);
+  EXPECT_TRUE(controller.IsLocked());
+  EXPECT_EQ(controller.GetDefaultKeyring(), nullptr);
+
+  // Unlocking again after the lock still works
+  Unlock(&controller, "brave", &result);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(result);
+  EXPECT_FALSE(controller.IsLocked());
+}
+
+TEST_F(KeyringControllerUnitTest, ResetWhileUnlocking) {
+  KeyringController controller(GetPrefs());
+  ASSERT_NE(controller.CreateDefaultKeyring("brave"), nullptr);
+  controller.Lock();
+
+  bool result = true;
+  Unlock(&controller, "brave", &result);
+  controller.Reset();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(result);
+  EXPECT_TRUE(controller.IsLocked());
+  EXPECT_FALSE(controller.IsDefaultKeyringCreated());
+}
+
+TEST_F(KeyringControllerUnitTest, ConcurrentUnlocks) {
+  KeyringController controller(GetPrefs());
+  ASSERT_NE(controller.CreateDefaultKeyring("brave"), nullptr);
+  controller.Lock();
+
+  // A failed unlock completing after a successful one keeps it unlocked
+  bool result1 = false;
+  bool result2 = true;
+  Unlock(&controller, "brave", &result1);
+  Unlock(&controller, "brave123", &result2);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(result1);
+  EXPECT_FALSE(result2);
+  EXPECT_FALSE(controller.IsLocked());
+
+  controller.Lock();
+  result1 = true;
+  result2 = false;
+  Unlock(&controller, "brave123", &result1);
+  Unlock(&controller, "brave", &result2);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(result1);
+  EXPECT_TRUE(result2);
+  EXPECT_FALSE(controller.IsLocked());
+}
+
+TEST_F(KeyringControllerUnitTest, GetCachedAccountsForDefaultKeyring) {
+  KeyringController controller(GetPrefs());
+  EXPECT_TRUE(controller.GetCachedAccountsForDefaultKeyring().empty());
+
+  HDKeyring* keyring = controller.CreateDefaultKeyring("brave");
+  keyring->AddAccounts(2);
+  const std::vector<std::string> accounts = keyring->GetAccounts();
+  controller.Lock();
+  EXPECT_EQ(controller.GetCachedAccountsForDefaultKeyring(), accounts);
+
+  // The cache is encrypted
+  const std::string cached_accounts =
+      GetPrefs()->GetString(kBraveWalletDefaultKeyringEncryptedAccounts);
+  EXPECT_FALSE(cached_accounts.empty());
+  EXPECT_EQ(cached_accounts.find(accounts[0]), std::string::npos);
+
+  controller.Reset();
+  EXPECT_TRUE(controller.GetCachedAccountsForDefaultKeyring().empty());
+}
+
 }  // namespace brave_wallet
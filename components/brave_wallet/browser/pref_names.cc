@@ -13,6 +13,8 @@ const char kBraveWalletPasswordEncryptorNonce[] =
 const char kBraveWalletEncryptedMnemonic[] = "brave.wallet.encrypted_mnemonic";
 const char kBraveWalletDefaultKeyringAccountNum[] =
     "brave.wallet.default_keyring_account_num";
+const char kBraveWalletDefaultKeyringEncryptedAccounts[] =
+    "brave.wallet.default_keyring_encrypted_accounts";
 const char kShowWalletIconOnToolbar[] =
     "brave.wallet.show_wallet_icon_on_toolbar";
 const char kBraveWalletBackupComplete[] = "brave.wallet.wallet_backup_complete";
@@ -39,8 +39,10 @@ handler.on(WalletPageActions.createWallet.getType(), async (store, payload: Crea
 
 handler.on(WalletPageActions.restoreWallet.getType(), async (store, payload: RestoreWalletPayloadType) => {
   const apiProxy = await getAPIProxy()
-  await apiProxy.restoreWallet(payload.mnemonic, payload.password)
-  await apiProxy.notifyWalletBackupComplete()
+  const result = await apiProxy.restoreWallet(payload.mnemonic, payload.password)
+  if (result.success) {
+    await apiProxy.notifyWalletBackupComplete()
+  }
   await refreshWalletInfo(store)
 })
 
@@ -9,6 +9,10 @@ export interface CreateWalletReturnInfo {
   mnemonic: string
 }
 
+export interface RestoreWalletReturnInfo {
+  success: boolean
+}
+
 export interface GetRecoveryWordsReturnInfo {
   mnemonic: string
 }
@@ -17,7 +21,7 @@ export default class APIProxy {
   static getInstance: () => APIProxy
   getWalletHandler: () => WalletAPIHandler
   createWallet: (password: string) => Promise<CreateWalletReturnInfo>
-  restoreWallet: (mnemonic: string, password: string) => Promise<void>
+  restoreWallet: (mnemonic: string, password: string) => Promise<RestoreWalletReturnInfo>
   getRecoveryWords: () => Promise<GetRecoveryWordsReturnInfo>
   notifyWalletBackupComplete: () => Promise<void>
 }
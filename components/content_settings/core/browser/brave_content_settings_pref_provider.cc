@@ -5,7 +5,10 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <map>
 #include <memory>
+#include <set>
+#include <tuple>
 #include <utility>
 
 #include "base/bind.h"
@@ -88,32 +91,82 @@ class BraveShieldsRuleIterator : public RuleIterator {
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsRuleIterator);
 };
 
-
-bool IsActive(const Rule& cookie_rule,
-              const std::vector<Rule>& shield_rules) {
-  // don't include default rules in the iterator
-  if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
-      (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
-       cookie_rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://firstParty/*"))) {
-    return false;
+// Shield rules indexed by the host of their primary pattern. A shield rule
+// can only be identical to or less specific than a cookie rule when its host
+// is the cookie rule's host or one of its parent domains, so only those
+// rules need to be compared.
+class ShieldRulesIndex {
+ public:
+  explicit ShieldRulesIndex(const std::vector<Rule>& shield_rules)
+      : shield_rules_(shield_rules) {
+    for (size_t i = 0; i < shield_rules_.size(); ++i) {
+      const std::string& host = shield_rules_[i].primary_pattern.GetHost();
+      if (host.empty()) {
+        hostless_rules_.push_back(i);
+      } else {
+        rules_by_host_[host].push_back(i);
+      }
+    }
   }
 
-  bool default_value = true;
-  for (const auto& shield_rule : shield_rules) {
-    auto primary_compare =
-        shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
-    // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
-    if (primary_compare == ContentSettingsPattern::IDENTITY ||
-        primary_compare == ContentSettingsPattern::SUCCESSOR) {
-      // TODO(bridiver) - move this logic into shields_util for allow/block
-      return
-          ValueToContentSetting(&shield_rule.value) != CONTENT_SETTING_BLOCK;
+  bool IsActive(const Rule& cookie_rule) const {
+    // don't include default rules in the iterator
+    if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
+        (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
+         cookie_rule.secondary_pattern ==
+            ContentSettingsPattern::FromString("https://firstParty/*"))) {
+      return false;
     }
+
+    // Shield rules are in precedence order, so the first one that applies
+    // wins.
+    size_t first_match = shield_rules_.size();
+    const auto find_first_match = [&](const std::vector<size_t>& indices) {
+      for (size_t index : indices) {
+        if (index >= first_match)
+          break;
+        auto primary_compare = shield_rules_[index].primary_pattern.Compare(
+            cookie_rule.primary_pattern);
+        // TODO(bridiver) - verify that SUCCESSOR is correct and not
+        // PREDECESSOR
+        if (primary_compare == ContentSettingsPattern::IDENTITY ||
+            primary_compare == ContentSettingsPattern::SUCCESSOR) {
+          first_match = index;
+          break;
+        }
+      }
+    };
+
+    find_first_match(hostless_rules_);
+    const std::string& host = cookie_rule.primary_pattern.GetHost();
+    size_t pos = 0;
+    while (!host.empty()) {
+      auto it = rules_by_host_.find(host.substr(pos));
+      if (it != rules_by_host_.end())
+        find_first_match(it->second);
+
+      pos = host.find('.', pos);
+      if (pos == std::string::npos)
+        break;
+      ++pos;
+    }
+
+    if (first_match == shield_rules_.size())
+      return true;
+
+    // TODO(bridiver) - move this logic into shields_util for allow/block
+    return ValueToContentSetting(&shield_rules_[first_match].value) !=
+           CONTENT_SETTING_BLOCK;
   }
 
-  return default_value;
-}
+ private:
+  const std::vector<Rule>& shield_rules_;
+  // Indices into |shield_rules_|, in ascending order.
+  std::map<std::string, std::vector<size_t>> rules_by_host_;
+  std::vector<size_t> hostless_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldRulesIndex);
+};
 
 }  // namespace
 
@@ -503,9 +556,10 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
       ContentSettingsType::BRAVE_COOKIES, incognito);
 
   // Matching cookie rules against shield rules.
+  const ShieldRulesIndex shield_rules_index(shield_rules);
   while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
     auto rule = brave_cookies_iterator->Next();
-    if (IsActive(rule, shield_rules)) {
+    if (shield_rules_index.IsActive(rule)) {
       rules.emplace_back(CloneRule(rule, true));
       brave_cookie_rules_[incognito].emplace_back(CloneRule(rule, true));
     }
@@ -535,36 +589,35 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   }
 
   // get the list of changes
+  // we want an exact match here because any change to the rule is an update
+  std::set<std::tuple<ContentSettingsPattern, ContentSettingsPattern,
+                      ContentSetting>>
+      old_rule_settings;
+  for (const auto& old_rule : old_rules) {
+    old_rule_settings.emplace(old_rule.primary_pattern,
+                              old_rule.secondary_pattern,
+                              ValueToContentSetting(&old_rule.value));
+  }
+
   std::vector<Rule> brave_cookie_updates;
+  std::set<std::pair<ContentSettingsPattern, ContentSettingsPattern>>
+      new_rule_patterns;
   for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
+    new_rule_patterns.emplace(new_rule.primary_pattern,
+                              new_rule.secondary_pattern);
+    if (!old_rule_settings.count(std::make_tuple(
+            new_rule.primary_pattern, new_rule.secondary_pattern,
+            ValueToContentSetting(&new_rule.value)))) {
       brave_cookie_updates.emplace_back(CloneRule(new_rule));
     }
   }
 
   // find any removed rules
   for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
+    // we only care about the patterns here because we're looking
+    // for deleted rules, not changed rules
+    if (!new_rule_patterns.count(std::make_pair(old_rule.primary_pattern,
+                                                old_rule.secondary_pattern))) {
       brave_cookie_updates.emplace_back(
           Rule(old_rule.primary_pattern, old_rule.secondary_pattern,
                base::Value(), old_rule.expiration, old_rule.session_model));
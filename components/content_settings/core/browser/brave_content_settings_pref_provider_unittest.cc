@@ -8,6 +8,8 @@
 
 #include "base/macros.h"
 #include "base/optional.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
 #include "base/values.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -225,6 +227,26 @@ class ShieldsScriptSetting : public ShieldsSetting {
   }
 };
 
+class CookieSettingsObserver : public Observer {
+ public:
+  CookieSettingsObserver() = default;
+  ~CookieSettingsObserver() override = default;
+
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override {
+    if (content_type == ContentSettingsType::COOKIES)
+      change_count_++;
+  }
+
+  int change_count() const { return change_count_; }
+
+ private:
+  int change_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CookieSettingsObserver);
+};
+
 }  // namespace
 
 class BravePrefProviderTest : public testing::Test {
@@ -524,4 +546,79 @@ TEST_F(BravePrefProviderTest, TestShieldsSettingsMigrationFromUnknownSettings) {
   provider.ShutdownOnUIThread();
 }
 
+TEST_F(BravePrefProviderTest, TestCookieRulesWithManySiteExceptions) {
+  constexpr int kSiteCount = 10000;
+  PrefService* pref_service = testing_profile()->GetPrefs();
+
+  // Seed the exceptions directly so the provider builds its cookie rules
+  // once, instead of once per exception.
+  {
+    prefs::ScopedDictionaryPrefUpdate shields_pref_update(
+        pref_service,
+        GetShieldsSettingUserPrefsPath(brave_shields::kBraveShields));
+    std::unique_ptr<prefs::DictionaryValueUpdate> shields_dictionary =
+        shields_pref_update.Get();
+    prefs::ScopedDictionaryPrefUpdate cookies_pref_update(
+        pref_service, GetShieldsSettingUserPrefsPath(brave_shields::kCookies));
+    std::unique_ptr<prefs::DictionaryValueUpdate> cookies_dictionary =
+        cookies_pref_update.Get();
+
+    for (int i = 0; i < kSiteCount; ++i) {
+      const std::string patterns_string =
+          base::StringPrintf("[*.]site%d.com,*", i);
+      // Shields are down on every odd site.
+      shields_dictionary
+          ->SetDictionaryWithoutPathExpansion(
+              patterns_string, std::make_unique<base::DictionaryValue>())
+          ->SetInteger(kSettingPath,
+                       i % 2 ? CONTENT_SETTING_BLOCK : CONTENT_SETTING_ALLOW);
+      cookies_dictionary
+          ->SetDictionaryWithoutPathExpansion(
+              patterns_string, std::make_unique<base::DictionaryValue>())
+          ->SetInteger(kSettingPath, CONTENT_SETTING_BLOCK);
+    }
+  }
+
+  BravePrefProvider provider(pref_service, false /* incognito */,
+                             true /* store_last_modified */,
+                             false /* restore_session */);
+  CookieSettingsObserver observer;
+  provider.AddObserver(&observer);
+
+  const GURL tracker_url("https://tracker.com");
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            TestUtils::GetContentSetting(&provider, tracker_url,
+                                         GURL("https://site0.com"),
+                                         ContentSettingsType::COOKIES, false));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            TestUtils::GetContentSetting(&provider, tracker_url,
+                                         GURL("https://www.site1.com"),
+                                         ContentSettingsType::COOKIES, false));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            TestUtils::GetContentSetting(&provider, tracker_url,
+                                         GURL("https://site9998.com"),
+                                         ContentSettingsType::COOKIES, false));
+
+  // Turning shields down for one site only reports the cookie rule that
+  // changed for that site.
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("[*.]site0.com"),
+      ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+      ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            TestUtils::GetContentSetting(&provider, tracker_url,
+                                         GURL("https://site0.com"),
+                                         ContentSettingsType::COOKIES, false));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            TestUtils::GetContentSetting(&provider, tracker_url,
+                                         GURL("https://site2.com"),
+                                         ContentSettingsType::COOKIES, false));
+  EXPECT_EQ(1, observer.change_count());
+
+  provider.RemoveObserver(&observer);
+  provider.ShutdownOnUIThread();
+}
+
 }  //  namespace content_settings
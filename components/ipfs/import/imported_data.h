@@ -38,6 +38,13 @@ struct ImportedData {
 using ImportCompletedCallback =
     base::OnceCallback<void(const ipfs::ImportedData&)>;
 
+// Reports a file added to ipfs during a chunked folder import with
+// the number of files imported so far and the total number of files.
+using ImportProgressCallback =
+    base::RepeatingCallback<void(const std::string& filename,
+                                 size_t imported_files,
+                                 size_t total_files)>;
+
 }  // namespace ipfs
 
 #endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IMPORTED_DATA_H_
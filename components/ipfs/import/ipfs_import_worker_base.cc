@@ -5,6 +5,7 @@
 
 #include "brave/components/ipfs/import/ipfs_import_worker_base.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/command_line.h"
@@ -35,11 +36,23 @@
 #include "net/http/http_response_headers.h"
 #include "net/http/http_status_code.h"
 #include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "third_party/blink/public/mojom/blob/serialized_blob.mojom.h"
 #include "url/gurl.h"
 
 namespace {
 
+// Maximum number of /api/v0/add requests running at the same time.
+const size_t kMaxConcurrentChunkUploads = 4;
+// Maximum number of /api/v0/files/mkdir and /api/v0/files/cp requests running
+// at the same time.
+const size_t kMaxConcurrentStitchRequests = 8;
+// A chunk is closed when it reaches either of the limits below.
+const int64_t kMaxChunkSizeInBytes = 16 * 1024 * 1024;
+const size_t kMaxFilesPerChunk = 64;
+// /api/v0/files/stat returns a small JSON object.
+const size_t kMaxStatResponseSize = 64 * 1024;
+
 // Return a date string formatted as "YYYY-MM-DD".
 std::string TimeFormatDate(const base::Time& time) {
   base::Time::Exploded exploded_time;
@@ -52,6 +65,60 @@ std::string TimeFormatDate(const base::Time& time) {
 
 namespace ipfs {
 
+// Uploads a single chunk of files and splits the streamed NDJSON response
+// of /api/v0/add into lines as they arrive.
+class IpfsImportWorkerBase::ChunkUploader
+    : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  ChunkUploader(IpfsImportWorkerBase* worker,
+                std::unique_ptr<network::SimpleURLLoader> url_loader)
+      : worker_(worker), url_loader_(std::move(url_loader)) {}
+  ~ChunkUploader() override = default;
+
+  ChunkUploader(const ChunkUploader&) = delete;
+  ChunkUploader& operator=(const ChunkUploader&) = delete;
+
+  void Start(network::mojom::URLLoaderFactory* url_loader_factory) {
+    url_loader_->DownloadAsStream(url_loader_factory, this);
+  }
+
+  // network::SimpleURLLoaderStreamConsumer
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    buffer_.append(string_piece.data(), string_piece.size());
+    size_t line_start = 0;
+    size_t line_end = buffer_.find('\n');
+    while (line_end != std::string::npos) {
+      worker_->OnChunkEntryImported(
+          buffer_.substr(line_start, line_end - line_start));
+      line_start = line_end + 1;
+      line_end = buffer_.find('\n', line_start);
+    }
+    buffer_.erase(0, line_start);
+    std::move(resume).Run();
+  }
+
+  void OnComplete(bool success) override {
+    int response_code = -1;
+    if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
+      response_code = url_loader_->ResponseInfo()->headers->response_code();
+    success = success && url_loader_->NetError() == net::OK &&
+              response_code == net::HTTP_OK;
+    if (success && !buffer_.empty())
+      worker_->OnChunkEntryImported(buffer_);
+    buffer_.clear();
+    // |this| is deleted by the call below.
+    worker_->OnChunkUploadCompleted(this, success);
+  }
+
+  void OnRetry(base::OnceClosure start_retry) override { NOTREACHED(); }
+
+ private:
+  IpfsImportWorkerBase* worker_ = nullptr;
+  std::unique_ptr<network::SimpleURLLoader> url_loader_;
+  std::string buffer_;
+};
+
 IpfsImportWorkerBase::IpfsImportWorkerBase(
     BlobContextGetterFactory* blob_context_getter_factory,
     network::mojom::URLLoaderFactory* url_loader_factory,
@@ -98,6 +165,229 @@ void IpfsImportWorkerBase::ImportFolder(const base::FilePath folder_path) {
                          std::move(upload_callback));
 }
 
+void IpfsImportWorkerBase::ImportFolderInChunks(
+    const base::FilePath folder_path,
+    ImportProgressCallback progress_callback) {
+  data_->filename = folder_path.BaseName().MaybeAsASCII();
+  chunked_folder_path_ = folder_path;
+  progress_callback_ = std::move(progress_callback);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(&EnumerateDirectoryFiles, folder_path),
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderEnumerated,
+                     weak_factory_.GetWeakPtr(), folder_path));
+}
+
+void IpfsImportWorkerBase::OnFolderEnumerated(
+    const base::FilePath& folder_path,
+    std::vector<ImportFileInfo> files) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const base::FilePath upload_root = folder_path.DirName();
+  chunked_directories_.push_back(data_->filename);
+  int64_t chunk_size = 0;
+  std::vector<ImportFileInfo> chunk;
+  for (auto& file : files) {
+    base::FilePath::StringType relative_path;
+    if (!GetRelativePathComponent(upload_root, file.path, &relative_path))
+      continue;
+    std::string name = base::FilePath(relative_path).MaybeAsASCII();
+    if (file.info.IsDirectory()) {
+      chunked_directories_.push_back(name);
+      continue;
+    }
+    chunked_files_[name] = std::string();
+    chunked_total_size_ += file.info.GetSize();
+    chunk_size += file.info.GetSize();
+    chunk.push_back(std::move(file));
+    if (chunk_size >= kMaxChunkSizeInBytes ||
+        chunk.size() >= kMaxFilesPerChunk) {
+      pending_chunks_.push(std::move(chunk));
+      chunk.clear();
+      chunk_size = 0;
+    }
+  }
+  if (!chunk.empty())
+    pending_chunks_.push(std::move(chunk));
+  if (pending_chunks_.empty())
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_REQUEST_EMPTY);
+  // Parents have shorter paths, so they are created first.
+  std::sort(chunked_directories_.begin(), chunked_directories_.end());
+  StartChunkUploads();
+}
+
+void IpfsImportWorkerBase::StartChunkUploads() {
+  while (chunk_requests_in_progress_ < kMaxConcurrentChunkUploads &&
+         !pending_chunks_.empty()) {
+    ++chunk_requests_in_progress_;
+    CreateRequestForFileList(
+        base::BindOnce(&IpfsImportWorkerBase::UploadChunk,
+                       weak_factory_.GetWeakPtr()),
+        blob_context_getter_factory_, chunked_folder_path_,
+        std::move(pending_chunks_.front()));
+    pending_chunks_.pop();
+  }
+}
+
+void IpfsImportWorkerBase::UploadChunk(
+    std::unique_ptr<network::ResourceRequest> request) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!callback_)
+    return;
+  if (!request)
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_REQUEST_EMPTY);
+  if (!server_endpoint_.is_valid())
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+
+  GURL url = net::AppendQueryParameter(server_endpoint_.Resolve(kImportAddPath),
+                                       "stream-channels", "true");
+  url = net::AppendQueryParameter(url, "wrap-with-directory", "false");
+  url = net::AppendQueryParameter(url, "pin", "false");
+  url = net::AppendQueryParameter(url, "progress", "false");
+
+  chunk_uploaders_.push_back(std::make_unique<ChunkUploader>(
+      this, CreateURLLoader(url, "POST", std::move(request))));
+  chunk_uploaders_.back()->Start(url_loader_factory_);
+}
+
+void IpfsImportWorkerBase::OnChunkEntryImported(const std::string& line) {
+  if (line.empty() || line.front() != '{' || line.back() != '}')
+    return;
+  ipfs::ImportedData entry;
+  if (!IPFSJSONParser::GetImportResponseFromJSON(line, &entry))
+    return;
+  auto it = chunked_files_.find(entry.filename);
+  // Directory entries and duplicates are not counted.
+  if (it == chunked_files_.end() || !it->second.empty() || entry.hash.empty())
+    return;
+  it->second = entry.hash;
+  ++imported_files_;
+  if (progress_callback_)
+    progress_callback_.Run(entry.filename, imported_files_,
+                           chunked_files_.size());
+}
+
+void IpfsImportWorkerBase::OnChunkUploadCompleted(ChunkUploader* uploader,
+                                                  bool success) {
+  auto it = std::find_if(
+      chunk_uploaders_.begin(), chunk_uploaders_.end(),
+      [uploader](const auto& item) { return item.get() == uploader; });
+  DCHECK(it != chunk_uploaders_.end());
+  chunk_uploaders_.erase(it);
+  --chunk_requests_in_progress_;
+  if (!callback_)
+    return;
+  if (!success) {
+    // Drop the rest of the uploads, the result is reported only once.
+    chunk_uploaders_.clear();
+    base::queue<std::vector<ImportFileInfo>>().swap(pending_chunks_);
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+  }
+  if (!pending_chunks_.empty())
+    return StartChunkUploads();
+  if (chunk_requests_in_progress_)
+    return;
+  if (imported_files_ != chunked_files_.size())
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
+
+  std::string directory = kImportDirectory;
+  directory += TimeFormatDate(base::Time::Now());
+  directory += "/";
+  data_->directory = directory;
+  GURL mkdir_url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportMakeDirectoryPath), "parents", "true");
+  for (const auto& name : chunked_directories_) {
+    stitch_requests_.push(
+        net::AppendQueryParameter(mkdir_url, "arg", directory + name));
+  }
+  GURL copy_url = server_endpoint_.Resolve(kImportCopyPath);
+  for (const auto& file : chunked_files_) {
+    GURL url =
+        net::AppendQueryParameter(copy_url, "arg", "/ipfs/" + file.second);
+    pending_copy_requests_.push(
+        net::AppendQueryParameter(url, "arg", directory + file.first));
+  }
+  StartStitchRequests();
+}
+
+void IpfsImportWorkerBase::StartStitchRequests() {
+  // Files are copied only once all directories are created.
+  if (stitch_requests_.empty() && stitch_loaders_.empty())
+    std::swap(stitch_requests_, pending_copy_requests_);
+  if (stitch_requests_.empty() && stitch_loaders_.empty())
+    return RequestFolderHash();
+  while (stitch_loaders_.size() < kMaxConcurrentStitchRequests &&
+         !stitch_requests_.empty()) {
+    stitch_loaders_.push_back(
+        CreateURLLoader(stitch_requests_.front(), "POST"));
+    stitch_requests_.pop();
+    network::SimpleURLLoader* loader = stitch_loaders_.back().get();
+    loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+        url_loader_factory_,
+        base::BindOnce(&IpfsImportWorkerBase::OnStitchRequestCompleted,
+                       base::Unretained(this), loader));
+  }
+}
+
+void IpfsImportWorkerBase::OnStitchRequestCompleted(
+    network::SimpleURLLoader* loader,
+    std::unique_ptr<std::string> response_body) {
+  auto it = std::find_if(
+      stitch_loaders_.begin(), stitch_loaders_.end(),
+      [loader](const auto& item) { return item.get() == loader; });
+  DCHECK(it != stitch_loaders_.end());
+  int error_code = loader->NetError();
+  int response_code = -1;
+  if (loader->ResponseInfo() && loader->ResponseInfo()->headers)
+    response_code = loader->ResponseInfo()->headers->response_code();
+  stitch_loaders_.erase(it);
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success) {
+    VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
+            << " response_body:" << (response_body ? *response_body : "");
+    // Drop the rest of the requests, the result is reported only once.
+    stitch_loaders_.clear();
+    base::queue<GURL>().swap(stitch_requests_);
+    base::queue<GURL>().swap(pending_copy_requests_);
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_MOVE_FAILED);
+  }
+  StartStitchRequests();
+}
+
+void IpfsImportWorkerBase::RequestFolderHash() {
+  DCHECK(!url_loader_);
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportStatPath), "arg",
+      data_->directory + data_->filename);
+  url = net::AppendQueryParameter(url, "hash", "true");
+  url_loader_ = CreateURLLoader(url, "POST");
+  url_loader_->DownloadToString(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderHashReceived,
+                     base::Unretained(this)),
+      kMaxStatResponseSize);
+}
+
+void IpfsImportWorkerBase::OnFolderHashReceived(
+    std::unique_ptr<std::string> response_body) {
+  int error_code = url_loader_->NetError();
+  int response_code = -1;
+  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
+    response_code = url_loader_->ResponseInfo()->headers->response_code();
+  url_loader_.reset();
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK &&
+                  response_body);
+  ipfs::ImportedData stat;
+  if (success)
+    success = IPFSJSONParser::GetImportResponseFromJSON(*response_body, &stat);
+  if (!success || stat.hash.empty())
+    return NotifyImportCompleted(IPFS_IMPORT_ERROR_MOVE_FAILED);
+  data_->hash = stat.hash;
+  data_->size = chunked_total_size_;
+  if (!key_to_publish_.empty())
+    return PublishContent();
+  NotifyImportCompleted(IPFS_IMPORT_SUCCESS);
+}
+
 void IpfsImportWorkerBase::ImportText(const std::string& text,
                                       const std::string& host) {
   if (text.empty() || host.empty()) {
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_IMPORT_WORKER_BASE_H_
 
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -42,6 +43,15 @@ namespace ipfs {
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
 //   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
 //   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
+// Folders may also be imported in chunks, in that case steps 2-4 become:
+//   2. Splits files into chunks and sends up to kMaxConcurrentChunkUploads
+//      of them in parallel using IPFS api (/api/v0/add), each response is
+//      parsed line by line while it streams in to report per-file progress
+//   3. Creates the folder tree inside the target directory
+//      using IPFS api(/api/v0/files/mkdir)
+//   4. Copies each added file to its place in the tree
+//      using IPFS api(/api/v0/files/cp) and reads the resulting folder hash
+//      using IPFS api(/api/v0/files/stat)
 class IpfsImportWorkerBase {
  public:
   IpfsImportWorkerBase(BlobContextGetterFactory* blob_context_getter_factory,
@@ -60,6 +70,8 @@ class IpfsImportWorkerBase {
                   const std::string& filename);
   void ImportText(const std::string& text, const std::string& host);
   void ImportFolder(const base::FilePath folder_path);
+  void ImportFolderInChunks(const base::FilePath folder_path,
+                            ImportProgressCallback progress_callback);
 
  protected:
   network::mojom::URLLoaderFactory* GetUrlLoaderFactory();
@@ -80,6 +92,21 @@ class IpfsImportWorkerBase {
                          ipfs::ImportedData* data);
   void PublishContent();
   void OnContentPublished(std::unique_ptr<std::string> response_body);
+
+  // Chunked folder import.
+  class ChunkUploader;
+  void OnFolderEnumerated(const base::FilePath& folder_path,
+                          std::vector<ImportFileInfo> files);
+  void StartChunkUploads();
+  void UploadChunk(std::unique_ptr<network::ResourceRequest> request);
+  void OnChunkEntryImported(const std::string& line);
+  void OnChunkUploadCompleted(ChunkUploader* uploader, bool success);
+  void StartStitchRequests();
+  void OnStitchRequestCompleted(network::SimpleURLLoader* loader,
+                                std::unique_ptr<std::string> response_body);
+  void RequestFolderHash();
+  void OnFolderHashReceived(std::unique_ptr<std::string> response_body);
+
   ImportCompletedCallback callback_;
   std::unique_ptr<ipfs::ImportedData> data_;
 
@@ -88,6 +115,24 @@ class IpfsImportWorkerBase {
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
   GURL server_endpoint_;
   std::string key_to_publish_;
+
+  base::FilePath chunked_folder_path_;
+  ImportProgressCallback progress_callback_;
+  base::queue<std::vector<ImportFileInfo>> pending_chunks_;
+  std::list<std::unique_ptr<ChunkUploader>> chunk_uploaders_;
+  size_t chunk_requests_in_progress_ = 0;
+  // Relative names of the files that are not added yet, mapped to their
+  // hashes once the add response arrives.
+  std::map<std::string, std::string> chunked_files_;
+  std::vector<std::string> chunked_directories_;
+  size_t imported_files_ = 0;
+  int64_t chunked_total_size_ = 0;
+  // Requests of the current stitch step; the directories are all created
+  // before |pending_copy_requests_| copy the files into them.
+  base::queue<GURL> stitch_requests_;
+  base::queue<GURL> pending_copy_requests_;
+  std::list<std::unique_ptr<network::SimpleURLLoader>> stitch_loaders_;
+
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
 };
 
@@ -57,40 +57,7 @@ net::NetworkTrafficAnnotationTag GetIpfsNetworkTrafficAnnotationTag() {
 }
 
 #if BUILDFLAG(IPFS_LOCAL_NODE_ENABLED)
-struct ImportFileInfo {
-  ImportFileInfo(base::FilePath full_path,
-                 base::FileEnumerator::FileInfo information) {
-    path = full_path;
-    info = information;
-  }
-  base::FilePath path;
-  base::FileEnumerator::FileInfo info;
-};
-
-bool GetRelativePathComponent(const base::FilePath& parent,
-                              const base::FilePath& child,
-                              base::FilePath::StringType* out) {
-  if (!parent.IsParent(child))
-    return false;
-
-  std::vector<base::FilePath::StringType> parent_components;
-  std::vector<base::FilePath::StringType> child_components;
-  parent.GetComponents(&parent_components);
-  child.GetComponents(&child_components);
-
-  size_t i = 0;
-  while (i < parent_components.size() &&
-         child_components[i] == parent_components[i]) {
-    ++i;
-  }
-
-  while (i < child_components.size()) {
-    out->append(child_components[i]);
-    if (++i < child_components.size())
-      out->append(FILE_PATH_LITERAL("/"));
-  }
-  return true;
-}
+using ipfs::ImportFileInfo;
 
 std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithText(
     const std::string& text,
@@ -144,7 +111,7 @@ std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFolder(
   for (const auto& info : files) {
     std::string data_header;
     base::FilePath::StringType relative_path;
-    GetRelativePathComponent(upload_path, info.path, &relative_path);
+    ipfs::GetRelativePathComponent(upload_path, info.path, &relative_path);
 
     std::string mime_type = info.info.IsDirectory() ? ipfs::kDirectoryMimeType
                                                     : ipfs::kFileMimeType;
@@ -189,6 +156,40 @@ std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(
 }
 
 #if BUILDFLAG(IPFS_LOCAL_NODE_ENABLED)
+ImportFileInfo::ImportFileInfo(base::FilePath full_path,
+                               base::FileEnumerator::FileInfo information) {
+  path = full_path;
+  info = information;
+}
+
+ImportFileInfo::ImportFileInfo(const ImportFileInfo& other) = default;
+ImportFileInfo::~ImportFileInfo() = default;
+
+bool GetRelativePathComponent(const base::FilePath& parent,
+                              const base::FilePath& child,
+                              base::FilePath::StringType* out) {
+  if (!parent.IsParent(child))
+    return false;
+
+  std::vector<base::FilePath::StringType> parent_components;
+  std::vector<base::FilePath::StringType> child_components;
+  parent.GetComponents(&parent_components);
+  child.GetComponents(&child_components);
+
+  size_t i = 0;
+  while (i < parent_components.size() &&
+         child_components[i] == parent_components[i]) {
+    ++i;
+  }
+
+  while (i < child_components.size()) {
+    out->append(child_components[i]);
+    if (++i < child_components.size())
+      out->append(FILE_PATH_LITERAL("/"));
+  }
+  return true;
+}
+
 std::unique_ptr<network::ResourceRequest> CreateResourceRequest(
     BlobBuilderCallback blob_builder_callback,
     const std::string& content_type,
@@ -8,18 +8,16 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "url/gurl.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
-
 namespace net {
 struct NetworkTrafficAnnotationTag;
 }  // namespace net
@@ -41,6 +39,22 @@ std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(
     std::unique_ptr<network::ResourceRequest> request = nullptr);
 
 #if BUILDFLAG(IPFS_LOCAL_NODE_ENABLED)
+struct ImportFileInfo {
+  ImportFileInfo(base::FilePath full_path,
+                 base::FileEnumerator::FileInfo information);
+  ImportFileInfo(const ImportFileInfo& other);
+  ~ImportFileInfo();
+
+  base::FilePath path;
+  base::FileEnumerator::FileInfo info;
+};
+
+// Writes to |out| the components of |child| relative to |parent| joined
+// with '/', returns false if |parent| is not a parent of |child|.
+bool GetRelativePathComponent(const base::FilePath& parent,
+                              const base::FilePath& child,
+                              base::FilePath::StringType* out);
+
 void AddMultipartHeaderForUploadWithFileName(const std::string& value_name,
                                              const std::string& file_name,
                                              const std::string& absolute_path,
@@ -64,6 +78,17 @@ void CreateRequestForFile(const base::FilePath& upload_file_path,
                           ResourceRequestGetter request_callback,
                           size_t file_size);
 
+// Must be called on a sequence that allows blocking, symlinks are skipped.
+std::vector<ImportFileInfo> EnumerateDirectoryFiles(base::FilePath dir_path);
+
+// Creates a multipart upload request for |files|, the names of the parts are
+// relative to the parent directory of |folder_path|.
+void CreateRequestForFileList(
+    ResourceRequestGetter request_callback,
+    BlobContextGetterFactory* blob_context_getter_factory,
+    const base::FilePath& folder_path,
+    std::vector<ImportFileInfo> files);
+
 void CreateRequestForFolder(const base::FilePath& folder_path,
                             BlobContextGetterFactory* context_getter_factory,
                             ResourceRequestGetter request_callback);
@@ -371,6 +371,36 @@ void IpfsService::ImportDirectoryToIpfs(const base::FilePath& folder,
   importers_[hash]->ImportFolder(folder);
 }
 
+void IpfsService::ImportDirectoryToIpfsInChunks(
+    const base::FilePath& folder,
+    const std::string& key,
+    ImportProgressCallback progress_callback,
+    ImportCompletedCallback callback) {
+  if (folder.empty()) {
+    if (callback)
+      std::move(callback).Run(ipfs::ImportedData());
+    return;
+  }
+  ReentrancyCheck reentrancy_check(&reentrancy_guard_);
+  if (!IsDaemonLaunched()) {
+    StartDaemonAndLaunch(base::BindOnce(
+        &IpfsService::ImportDirectoryToIpfsInChunks, weak_factory_.GetWeakPtr(),
+        folder, key, std::move(progress_callback), std::move(callback)));
+    return;
+  }
+  size_t hash =
+      base::FastHash(base::as_bytes(base::make_span(folder.MaybeAsASCII())));
+  if (importers_.count(hash))
+    return;
+  auto import_completed_callback =
+      base::BindOnce(&IpfsService::OnImportFinished, weak_factory_.GetWeakPtr(),
+                     std::move(callback), hash);
+  importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
+      blob_context_getter_factory_.get(), url_loader_factory_.get(),
+      server_endpoint_, std::move(import_completed_callback), key);
+  importers_[hash]->ImportFolderInChunks(folder, std::move(progress_callback));
+}
+
 void IpfsService::ImportTextToIpfs(const std::string& text,
                                    const std::string& host,
                                    ipfs::ImportCompletedCallback callback) {
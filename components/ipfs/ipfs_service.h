@@ -109,6 +109,13 @@ class IpfsService : public KeyedService,
   virtual void ImportDirectoryToIpfs(const base::FilePath& folder,
                                      const std::string& key,
                                      ImportCompletedCallback callback);
+  // Streams the folder through several concurrent add requests and reports
+  // each added file to |progress_callback|.
+  virtual void ImportDirectoryToIpfsInChunks(
+      const base::FilePath& folder,
+      const std::string& key,
+      ImportProgressCallback progress_callback,
+      ImportCompletedCallback callback);
   virtual void ImportLinkToIpfs(const GURL& url,
                                 ImportCompletedCallback callback);
   virtual void ImportTextToIpfs(const std::string& text,
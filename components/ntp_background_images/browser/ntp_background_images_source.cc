@@ -25,11 +25,36 @@ namespace ntp_background_images {
 
 namespace {
 
-base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+// Upper bound on the total size of the images kept in memory.
+constexpr size_t kMaxImageCacheSize = 32 * 1024 * 1024;
+
+scoped_refptr<base::RefCountedMemory> ReadImageFile(
+    const base::FilePath& path) {
   std::string contents;
   if (!base::ReadFileToString(path, &contents))
-    return base::Optional<std::string>();
-  return contents;
+    return nullptr;
+  return base::RefCountedString::TakeString(&contents);
+}
+
+std::vector<std::pair<base::FilePath, scoped_refptr<base::RefCountedMemory>>>
+ReadImageFiles(const std::vector<base::FilePath>& paths) {
+  std::vector<std::pair<base::FilePath, scoped_refptr<base::RefCountedMemory>>>
+      images;
+  size_t total_size = 0;
+  for (const auto& path : paths) {
+    int64_t file_size = 0;
+    if (!base::GetFileSize(path, &file_size) ||
+        total_size + file_size > kMaxImageCacheSize)
+      continue;
+
+    auto bytes = ReadImageFile(path);
+    if (!bytes)
+      continue;
+
+    total_size += bytes->size();
+    images.emplace_back(path, std::move(bytes));
+  }
+  return images;
 }
 
 bool IsSuperReferralPath(const std::string& path) {
@@ -41,10 +66,16 @@ bool IsSuperReferralPath(const std::string& path) {
 NTPBackgroundImagesSource::NTPBackgroundImagesSource(
     NTPBackgroundImagesService* service)
     : service_(service),
+      image_cache_(base::MRUCache<base::FilePath,
+                                  scoped_refptr<base::RefCountedMemory>>::
+                       NO_AUTO_EVICT),
       weak_factory_(this) {
+  service_->AddObserver(this);
 }
 
-NTPBackgroundImagesSource::~NTPBackgroundImagesSource() = default;
+NTPBackgroundImagesSource::~NTPBackgroundImagesSource() {
+  service_->RemoveObserver(this);
+}
 
 std::string NTPBackgroundImagesSource::GetSource() {
   return kBrandedWallpaperHost;
@@ -99,25 +130,100 @@ void NTPBackgroundImagesSource::StartDataRequest(
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  auto it = image_cache_.Get(image_file_path);
+  if (it != image_cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&ReadImageFile, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     image_cache_generation_, std::move(callback)));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
+    const base::FilePath& image_file_path,
+    int image_cache_generation,
     GotDataCallback callback,
-    base::Optional<std::string> input) {
-  if (!input)
-    return;
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes && image_cache_generation == image_cache_generation_)
+    AddToImageCache(image_file_path, bytes);
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
   std::move(callback).Run(std::move(bytes));
 }
 
+void NTPBackgroundImagesSource::OnUpdated(NTPBackgroundImagesData* data) {
+  ClearImageCache();
+}
+
+void NTPBackgroundImagesSource::OnSuperReferralEnded() {
+  ClearImageCache();
+}
+
+void NTPBackgroundImagesSource::PrewarmImageCache(
+    const std::vector<base::FilePath>& image_file_paths) {
+  std::vector<base::FilePath> uncached_image_file_paths;
+  for (const auto& image_file_path : image_file_paths) {
+    if (!image_file_path.empty() &&
+        image_cache_.Peek(image_file_path) == image_cache_.end())
+      uncached_image_file_paths.push_back(image_file_path);
+  }
+  if (uncached_image_file_paths.empty())
+    return;
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&ReadImageFiles, std::move(uncached_image_file_paths)),
+      base::BindOnce(&NTPBackgroundImagesSource::OnPrewarmedImageCache,
+                     weak_factory_.GetWeakPtr(), image_cache_generation_));
+}
+
+void NTPBackgroundImagesSource::OnPrewarmedImageCache(
+    int image_cache_generation,
+    ImageFiles images) {
+  if (image_cache_generation != image_cache_generation_)
+    return;
+
+  for (auto& image : images)
+    AddToImageCache(image.first, std::move(image.second));
+}
+
+base::WeakPtr<NTPBackgroundImagesSource>
+NTPBackgroundImagesSource::GetWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+void NTPBackgroundImagesSource::AddToImageCache(
+    const base::FilePath& image_file_path,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes->size() > kMaxImageCacheSize)
+    return;
+
+  auto it = image_cache_.Peek(image_file_path);
+  if (it != image_cache_.end()) {
+    image_cache_size_ -= it->second->size();
+    image_cache_.Erase(it);
+  }
+
+  image_cache_size_ += bytes->size();
+  image_cache_.Put(image_file_path, std::move(bytes));
+
+  while (image_cache_size_ > kMaxImageCacheSize) {
+    auto oldest = image_cache_.rbegin();
+    image_cache_size_ -= oldest->second->size();
+    image_cache_.Erase(oldest);
+  }
+}
+
+void NTPBackgroundImagesSource::ClearImageCache() {
+  image_cache_.Clear();
+  image_cache_size_ = 0;
+  ++image_cache_generation_;
+}
+
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
   if (IsLogoPath(path) || IsTopSiteFaviconPath(path))
     return "image/png";
@@ -125,6 +231,8 @@ std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
 }
 
 bool NTPBackgroundImagesSource::AllowCaching() {
+  // Image urls are reused across component updates, so the renderer must not
+  // cache them. Repeated loads are served from |image_cache_| instead.
   return false;
 }
 
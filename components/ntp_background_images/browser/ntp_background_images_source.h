@@ -7,21 +7,26 @@
 #define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
-#include "base/optional.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "content/public/browser/url_data_source.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
-
 namespace ntp_background_images {
 
-class NTPBackgroundImagesService;
+struct NTPBackgroundImagesData;
 
-// This serves background image data.
-class NTPBackgroundImagesSource : public content::URLDataSource {
+// This serves background image data. Recently served images are kept in a
+// bounded in-memory cache which is dropped whenever the component data
+// changes. ViewCounterService prewarms it with the images the next new tab
+// page will show.
+class NTPBackgroundImagesSource : public content::URLDataSource,
+                                  public NTPBackgroundImagesService::Observer {
  public:
   explicit NTPBackgroundImagesSource(NTPBackgroundImagesService* service);
 
@@ -31,10 +36,21 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   NTPBackgroundImagesSource& operator=(
       const NTPBackgroundImagesSource&) = delete;
 
+  // Reads |image_file_paths| which are not cached yet into the cache.
+  void PrewarmImageCache(const std::vector<base::FilePath>& image_file_paths);
+
+  base::WeakPtr<NTPBackgroundImagesSource> GetWeakPtr();
+
  private:
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
+                           ImageCacheInvalidatedOnComponentUpdate);
+  friend class NTPBackgroundImagesViewCounterTest;
+
+  using ImageFiles = std::vector<
+      std::pair<base::FilePath, scoped_refptr<base::RefCountedMemory>>>;
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -44,10 +60,20 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   std::string GetMimeType(const std::string& path) override;
   bool AllowCaching() override;
 
+  // NTPBackgroundImagesService::Observer overrides:
+  void OnUpdated(NTPBackgroundImagesData* data) override;
+  void OnSuperReferralEnded() override;
+
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
-                      base::Optional<std::string> input);
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      int image_cache_generation,
+                      GotDataCallback callback,
+                      scoped_refptr<base::RefCountedMemory> bytes);
+  void OnPrewarmedImageCache(int image_cache_generation, ImageFiles images);
+  void AddToImageCache(const base::FilePath& image_file_path,
+                       scoped_refptr<base::RefCountedMemory> bytes);
+  void ClearImageCache();
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsDefaultLogoPath(const std::string& path) const;
@@ -58,6 +84,12 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   base::FilePath GetTopSiteFaviconFilePath(const std::string& path) const;
 
   NTPBackgroundImagesService* service_;  // not owned
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      image_cache_;
+  size_t image_cache_size_ = 0;
+  // Bumped whenever the cache is cleared so that reads started before that
+  // don't repopulate it with stale images.
+  int image_cache_generation_ = 0;
   base::WeakPtrFactory<NTPBackgroundImagesSource> weak_factory_;
 };
 
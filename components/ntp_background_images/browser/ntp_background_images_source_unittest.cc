@@ -6,6 +6,11 @@
 #include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -32,7 +37,24 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  std::string GetImageFile(const base::FilePath& image_file_path) {
+    std::string result;
+    base::RunLoop run_loop;
+    source_->GetImageFile(
+        image_file_path,
+        base::BindOnce(
+            [](base::OnceClosure quit_closure, std::string* result,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+              if (bytes)
+                *result = std::string(bytes->front_as<char>(), bytes->size());
+              std::move(quit_closure).Run();
+            },
+            run_loop.QuitClosure(), &result));
+    run_loop.Run();
+    return result;
+  }
+
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -78,6 +100,53 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest,
+       ImageCacheInvalidatedOnComponentUpdate) {
+  const std::string test_json_string = R"(
+      {
+        "schemaVersion": 1,
+        "logo": {
+          "imageUrl": "logo.png",
+          "alt": "Technikke: For music lovers",
+          "companyName": "Technikke",
+          "destinationUrl": "https://www.brave.com/"
+        },
+        "wallpapers": [
+          {
+            "imageUrl": "background-1.jpg"
+          }
+        ]
+      })";
+
+  base::ScopedTempDir old_component_dir;
+  ASSERT_TRUE(old_component_dir.CreateUniqueTempDir());
+  const base::FilePath old_image_file =
+      old_component_dir.GetPath().AppendASCII("background-1.jpg");
+  ASSERT_TRUE(base::WriteFile(old_image_file, "old"));
+
+  base::ScopedTempDir new_component_dir;
+  ASSERT_TRUE(new_component_dir.CreateUniqueTempDir());
+  const base::FilePath new_image_file =
+      new_component_dir.GetPath().AppendASCII("background-1.jpg");
+  ASSERT_TRUE(base::WriteFile(new_image_file, "new"));
+
+  service_->si_installed_dir_ = old_component_dir.GetPath();
+  service_->OnGetComponentJsonData(false, test_json_string);
+  source_->PrewarmImageCache({old_image_file});
+  task_environment.RunUntilIdle();
+
+  ASSERT_TRUE(base::WriteFile(old_image_file, "changed"));
+  EXPECT_EQ("old", GetImageFile(old_image_file));
+
+  // Swapping the component drops everything cached for the old one.
+  service_->si_installed_dir_ = new_component_dir.GetPath();
+  service_->OnGetComponentJsonData(false, test_json_string);
+  task_environment.RunUntilIdle();
+
+  EXPECT_EQ("changed", GetImageFile(old_image_file));
+  EXPECT_EQ("new", GetImageFile(new_image_file));
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
@@ -20,6 +20,7 @@
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/ntp_background_images/browser/features.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_source.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
 #include "brave/components/ntp_background_images/common/pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
@@ -57,12 +58,15 @@ void ViewCounterService::RegisterProfilePrefs(
       prefs::kNewTabPageShowBackgroundImage, true);
 }
 
-ViewCounterService::ViewCounterService(NTPBackgroundImagesService* service,
-                                       brave_ads::AdsService* ads_service,
-                                       PrefService* prefs,
-                                       PrefService* local_state,
-                                       bool is_supported_locale)
+ViewCounterService::ViewCounterService(
+    NTPBackgroundImagesService* service,
+    base::WeakPtr<NTPBackgroundImagesSource> source,
+    brave_ads::AdsService* ads_service,
+    PrefService* prefs,
+    PrefService* local_state,
+    bool is_supported_locale)
     : service_(service),
+      source_(source),
       ads_service_(ads_service),
       prefs_(prefs),
       is_supported_locale_(is_supported_locale) {
@@ -176,6 +180,7 @@ void ViewCounterService::OnUpdated(NTPBackgroundImagesData* data) {
     model_.ResetCurrentWallpaperImageIndex();
     model_.set_total_image_count(data->backgrounds.size());
     model_.set_ignore_count_to_branded_wallpaper(data->IsSuperReferral());
+    PrewarmCurrentWallpaper();
   }
 }
 
@@ -190,9 +195,25 @@ void ViewCounterService::ResetModel() {
     model_.Reset(false /* use_initial_count */);
     model_.set_total_image_count(data->backgrounds.size());
     model_.set_ignore_count_to_branded_wallpaper(data->IsSuperReferral());
+    PrewarmCurrentWallpaper();
   }
 }
 
+void ViewCounterService::PrewarmCurrentWallpaper() {
+  if (!source_ || !IsBrandedWallpaperActive())
+    return;
+
+  auto* data = GetCurrentBrandedWallpaperData();
+  const size_t index = model_.current_wallpaper_image_index();
+  if (!data->IsValid() || index >= data->backgrounds.size())
+    return;
+
+  const auto& background = data->backgrounds[index];
+  source_->PrewarmImageCache(
+      {background.image_file, background.logo ? background.logo->image_file
+                                              : data->default_logo.image_file});
+}
+
 void ViewCounterService::OnPreferenceChanged(const std::string& pref_name) {
   if (pref_name == prefs::kNewTabPageSuperReferralThemesOption) {
     // Reset model because SI and SR use different policy.
@@ -216,7 +237,10 @@ void ViewCounterService::RegisterPageView() {
   // since we want the count to start at the point of data being available
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
+    const int index = model_.current_wallpaper_image_index();
     model_.RegisterPageView();
+    if (index != model_.current_wallpaper_image_index())
+      PrewarmCurrentWallpaper();
   }
 }
 
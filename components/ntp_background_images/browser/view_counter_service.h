@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
@@ -31,6 +32,7 @@ class WeeklyStorage;
 
 namespace ntp_background_images {
 
+class NTPBackgroundImagesSource;
 struct NTPBackgroundImagesData;
 struct TopSite;
 
@@ -38,6 +40,7 @@ class ViewCounterService : public KeyedService,
                            public NTPBackgroundImagesService::Observer {
  public:
   ViewCounterService(NTPBackgroundImagesService* service,
+                     base::WeakPtr<NTPBackgroundImagesSource> source,
                      brave_ads::AdsService* ads_service,
                      PrefService* prefs,
                      PrefService* local_state,
@@ -98,6 +101,10 @@ class ViewCounterService : public KeyedService,
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
                            ActiveOptedInWithNTPBackgoundOption);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest, ModelTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
+                           PrewarmCurrentWallpaper);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
+                           NotPrewarmedOptedOut);
 
   void OnPreferenceChanged(const std::string& pref_name);
 
@@ -120,9 +127,14 @@ class ViewCounterService : public KeyedService,
 
   void ResetModel();
 
+  // Reads the images of the wallpaper the next new tab page will show into
+  // the cache of |source_|, if a branded wallpaper will be shown at all.
+  void PrewarmCurrentWallpaper();
+
   void UpdateP3AValues() const;
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
+  base::WeakPtr<NTPBackgroundImagesSource> source_;
   brave_ads::AdsService* ads_service_ = nullptr;  // not owned
   PrefService* prefs_ = nullptr;  // not owned
   bool is_supported_locale_ = false;
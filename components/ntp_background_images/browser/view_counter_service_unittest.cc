@@ -8,6 +8,8 @@
 
 #include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/test/task_environment.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
@@ -15,6 +17,7 @@
 #include "brave/components/ntp_background_images/browser/features.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_source.h"
 #include "brave/components/ntp_background_images/browser/view_counter_model.h"
 #include "brave/components/ntp_background_images/browser/view_counter_service.h"
 #include "brave/components/ntp_background_images/common/pref_names.h"
@@ -65,8 +68,10 @@ class NTPBackgroundImagesViewCounterTest : public testing::Test {
 
     service_ = std::make_unique<NTPBackgroundImagesService>(nullptr,
                                                             &local_pref_);
+    source_ = std::make_unique<NTPBackgroundImagesSource>(service_.get());
     view_counter_ = std::make_unique<ViewCounterService>(
-        service_.get(), nullptr, prefs(), &local_pref_, true);
+        service_.get(), source_->GetWeakPtr(), nullptr, prefs(), &local_pref_,
+        true);
 
     // Set referral service is properly initialized sr component is set.
     local_pref_.SetBoolean(kReferralCheckedForPromoCodeFile, true);
@@ -92,12 +97,30 @@ class NTPBackgroundImagesViewCounterTest : public testing::Test {
 
   sync_preferences::TestingPrefServiceSyncable* prefs() { return &prefs_; }
 
+  // Installs demo sponsored images whose files exist in |dir|.
+  void SetDemoWallpaperFiles(const base::FilePath& dir) {
+    auto demo = GetDemoWallpaper(false);
+    for (auto& background : demo->backgrounds) {
+      background.image_file = dir.Append(background.image_file);
+      ASSERT_TRUE(base::WriteFile(background.image_file, "wallpaper"));
+    }
+    demo->default_logo.image_file = dir.AppendASCII("logo.png");
+    ASSERT_TRUE(base::WriteFile(demo->default_logo.image_file, "logo"));
+    service_->si_images_data_ = std::move(demo);
+  }
+
+  bool IsImageCached(const base::FilePath& image_file_path) {
+    return source_->image_cache_.Peek(image_file_path) !=
+           source_->image_cache_.end();
+  }
+
  protected:
-  base::test::SingleThreadTaskEnvironment task_environment;
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<ViewCounterService> view_counter_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
+  std::unique_ptr<NTPBackgroundImagesSource> source_;
 };
 
 TEST_F(NTPBackgroundImagesViewCounterTest, NotActiveInitially) {
@@ -191,4 +214,46 @@ TEST_F(NTPBackgroundImagesViewCounterTest, ModelTest) {
 }
 #endif
 
+TEST_F(NTPBackgroundImagesViewCounterTest, PrewarmCurrentWallpaper) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  SetDemoWallpaperFiles(dir.GetPath());
+  const auto* data = service_->si_images_data_.get();
+
+  view_counter_->OnUpdated(service_->si_images_data_.get());
+  task_environment.RunUntilIdle();
+
+  // Only the images the next new tab page shows are read.
+  EXPECT_TRUE(IsImageCached(data->backgrounds[0].image_file));
+  EXPECT_TRUE(IsImageCached(data->default_logo.image_file));
+  EXPECT_FALSE(IsImageCached(data->backgrounds[1].image_file));
+  EXPECT_FALSE(IsImageCached(data->backgrounds[2].image_file));
+
+  // Moving on to the next wallpaper prewarms it.
+  while (view_counter_->model_.current_wallpaper_image_index() == 0)
+    view_counter_->RegisterPageView();
+  task_environment.RunUntilIdle();
+
+  EXPECT_TRUE(IsImageCached(data->backgrounds[1].image_file));
+  EXPECT_FALSE(IsImageCached(data->backgrounds[2].image_file));
+}
+
+TEST_F(NTPBackgroundImagesViewCounterTest, NotPrewarmedOptedOut) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  SetDemoWallpaperFiles(dir.GetPath());
+  const auto* data = service_->si_images_data_.get();
+
+  EnableNTPBGImagesPref(false);
+  view_counter_->OnUpdated(service_->si_images_data_.get());
+  task_environment.RunUntilIdle();
+  EXPECT_FALSE(IsImageCached(data->backgrounds[0].image_file));
+
+  EnableNTPBGImagesPref(true);
+  EnableSIPref(false);
+  view_counter_->OnUpdated(service_->si_images_data_.get());
+  task_environment.RunUntilIdle();
+  EXPECT_FALSE(IsImageCached(data->backgrounds[0].image_file));
+}
+
 }  // namespace ntp_background_images
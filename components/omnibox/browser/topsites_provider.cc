@@ -9,7 +9,11 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
@@ -21,6 +25,93 @@
 // Search Secondary Provider (suggestion)                              |  100++
 const int TopSitesProvider::kRelevance = 100;
 
+namespace {
+
+// Suffix array over the top sites list, so that finding the sites which
+// contain the input takes a binary search instead of a scan of every site.
+class TopSitesIndex {
+ public:
+  explicit TopSitesIndex(const std::vector<std::string>& sites)
+      : sites_(sites) {
+    for (size_t site = 0; site < sites_.size(); ++site) {
+      for (size_t offset = 0; offset < sites_[site].length(); ++offset)
+        suffixes_.push_back({site, offset});
+    }
+
+    std::sort(suffixes_.begin(), suffixes_.end(),
+              [this](const Suffix& lhs, const Suffix& rhs) {
+                return GetSuffix(lhs) < GetSuffix(rhs);
+              });
+  }
+
+  // Returns the index and first position of |text| of the highest ranked
+  // |max_matches| sites which contain |text|, in rank order.
+  std::vector<std::pair<size_t, size_t>> Find(const std::string& text,
+                                              size_t max_matches) const {
+    const base::StringPiece prefix(text);
+    const auto lower = std::lower_bound(
+        suffixes_.begin(), suffixes_.end(), prefix,
+        [this](const Suffix& suffix, base::StringPiece value) {
+          return GetSuffix(suffix).substr(0, value.length()) < value;
+        });
+    const auto upper = std::upper_bound(
+        lower, suffixes_.end(), prefix,
+        [this](base::StringPiece value, const Suffix& suffix) {
+          return value < GetSuffix(suffix).substr(0, value.length());
+        });
+
+    // When |text| is common, the best ranked sites containing it are found
+    // sooner by walking the list in rank order than by collecting every
+    // occurrence.
+    std::vector<std::pair<size_t, size_t>> matches;
+    if (static_cast<size_t>(upper - lower) > 4 * max_matches + 16) {
+      for (size_t site = 0;
+           site < sites_.size() && matches.size() < max_matches; ++site) {
+        const size_t position = sites_[site].find(text);
+        if (position != std::string::npos)
+          matches.emplace_back(site, position);
+      }
+      return matches;
+    }
+
+    // Sites are ranked by their position in the list.
+    base::flat_map<size_t, size_t> first_positions;
+    for (auto it = lower; it != upper; ++it) {
+      auto result = first_positions.emplace(it->site, it->offset);
+      if (!result.second)
+        result.first->second = std::min(result.first->second, it->offset);
+    }
+
+    for (const auto& first_position : first_positions) {
+      if (matches.size() == max_matches)
+        break;
+      matches.push_back(first_position);
+    }
+    return matches;
+  }
+
+ private:
+  struct Suffix {
+    size_t site;
+    size_t offset;
+  };
+
+  base::StringPiece GetSuffix(const Suffix& suffix) const {
+    return base::StringPiece(sites_[suffix.site]).substr(suffix.offset);
+  }
+
+  const std::vector<std::string>& sites_;
+  std::vector<Suffix> suffixes_;
+
+  DISALLOW_COPY_AND_ASSIGN(TopSitesIndex);
+};
+
+const TopSitesIndex& GetTopSitesIndex(const std::vector<std::string>& sites) {
+  static const base::NoDestructor<TopSitesIndex> index(sites);
+  return *index;
+}
+
+}  // namespace
 
 TopSitesProvider::TopSitesProvider(AutocompleteProviderClient* client)
     : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH), client_(client) {
@@ -42,16 +133,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
-       ++i) {
-    const std::string &current_site = *i;
-    size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+  for (const auto& site_match : GetTopSitesIndex(top_sites_).Find(
+           input_text, provider_max_matches())) {
+    const std::string& current_site = top_sites_[site_match.first];
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, site_match.second);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i) {
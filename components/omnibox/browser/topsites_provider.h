@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/compiler_specific.h"
+#include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/omnibox/browser/autocomplete_provider.h"
@@ -25,6 +26,8 @@ class TopSitesProvider : public AutocompleteProvider {
   void Start(const AutocompleteInput& input, bool minimal_changes) override;
 
  private:
+  FRIEND_TEST_ALL_PREFIXES(TopSitesProviderTest, MatchesLinearScan);
+
   ~TopSitesProvider() override;
 
   static const int kRelevance;
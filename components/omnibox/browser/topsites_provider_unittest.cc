@@ -5,6 +5,8 @@
 
 #include "brave/components/omnibox/browser/topsites_provider.h"
 
+#include <string>
+
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/omnibox/browser/fake_autocomplete_provider_client.h"
@@ -56,3 +58,48 @@ TEST_F(TopSitesProviderTest, NoMatchingWhenPrefIsOff) {
   provider_->Start(CreateAutocompleteInput("dex"), false);
   EXPECT_TRUE(provider_->matches().empty());
 }
+
+// Checks that matches are the same as those of a linear scan over the list,
+// for every substring of up to four characters of every top site.
+TEST_F(TopSitesProviderTest, MatchesLinearScan) {
+  for (const auto& site : TopSitesProvider::top_sites_) {
+    for (size_t start = 0; start < site.length(); ++start) {
+      for (size_t length = 1; length <= 4 && start + length <= site.length();
+           ++length) {
+        const std::string input_text = site.substr(start, length);
+        const AutocompleteInput input = CreateAutocompleteInput(input_text);
+        provider_->Start(input, false);
+        const auto& matches = provider_->matches();
+        if (input.type() == metrics::OmniboxInputType::QUERY) {
+          EXPECT_TRUE(matches.empty()) << input_text;
+          continue;
+        }
+
+        size_t match_index = 0;
+        for (const auto& current_site : TopSitesProvider::top_sites_) {
+          if (match_index == provider_->provider_max_matches())
+            break;
+          const size_t found_pos = current_site.find(input_text);
+          if (found_pos == std::string::npos)
+            continue;
+
+          ASSERT_LT(match_index, matches.size()) << input_text;
+          EXPECT_EQ(base::ASCIIToUTF16(current_site),
+                    matches[match_index].contents)
+              << input_text;
+          const ACMatchClassifications styles =
+              TopSitesProvider::StylesForSingleMatch(input_text, current_site,
+                                                     found_pos);
+          const auto& contents_class = matches[match_index].contents_class;
+          ASSERT_EQ(styles.size(), contents_class.size()) << input_text;
+          for (size_t i = 0; i < styles.size(); ++i) {
+            EXPECT_EQ(styles[i].offset, contents_class[i].offset);
+            EXPECT_EQ(styles[i].style, contents_class[i].style);
+          }
+          ++match_index;
+        }
+        EXPECT_EQ(match_index, matches.size()) << input_text;
+      }
+    }
+  }
+}
@@ -5,6 +5,8 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
@@ -34,6 +36,11 @@ void RecordP3A(uint64_t answers_count) {
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.P3A.SentAnswersCount", answer, 3);
 }
 
+bool IsP2AMetric(base::StringPiece histogram_name) {
+  return base::StartsWith(histogram_name, "Brave.P2A",
+                          base::CompareCase::SENSITIVE);
+}
+
 }  // namespace
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
@@ -74,8 +81,12 @@ void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DictionaryPrefUpdate update(local_state_, kPrefName);
   update->RemovePath(histogram_name);
 
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
+  // The staged payload can't be partially unstaged, so drop all of it. The
+  // other entries are still unsent and will be staged again.
+  if (has_staged_log() &&
+      std::find(staged_entry_keys_.begin(), staged_entry_keys_.end(),
+                histogram_name) != staged_entry_keys_.end()) {
+    staged_entry_keys_.clear();
     staged_log_.clear();
   }
 }
@@ -111,27 +122,18 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
+  DCHECK(has_staged_log());
   return staged_log_;
 }
 
 std::string BraveP3ALogStore::staged_log_type() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
-  if (base::StartsWith(iter->first, "Brave.P2A",
-                       base::CompareCase::SENSITIVE)) {
-    return "p2a";
-  }
-  return "p3a";
+  DCHECK(has_staged_log());
+  // All staged entries share the same type, see |StageNextLog|.
+  return IsP2AMetric(staged_entry_keys_.front()) ? "p2a" : "p3a";
 }
 
 const std::string& BraveP3ALogStore::staged_log_hash() const {
@@ -147,14 +149,36 @@ const std::string& BraveP3ALogStore::staged_log_signature() const {
 void BraveP3ALogStore::StageNextLog() {
   // Stage the next item.
   DCHECK(has_unsent_logs());
-  uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
+  const size_t unsent_count = unsent_entries_.size();
+  const uint64_t rand_idx = base::RandGenerator(unsent_count);
+  const bool is_p2a = IsP2AMetric(*(unsent_entries_.begin() + rand_idx));
+
+  // Starting from a random entry, collect up to |max_batch_size_| unsent
+  // entries of the same type, since P3A and P2A go to different endpoints.
+  staged_entry_keys_.clear();
+  std::vector<std::pair<std::string, uint64_t>> entries;
+  for (size_t i = 0;
+       i < unsent_count && staged_entry_keys_.size() < max_batch_size_; ++i) {
+    const std::string& key =
+        *(unsent_entries_.begin() + (rand_idx + i) % unsent_count);
+    if (IsP2AMetric(key) != is_p2a) {
+      continue;
+    }
+    auto iter = log_.find(key);
+    DCHECK(iter != log_.end());
+    DCHECK(!iter->second.sent);
+    staged_entry_keys_.push_back(key);
+    entries.emplace_back(key, iter->second.value);
+  }
 
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+  if (entries.size() == 1) {
+    staged_log_ = delegate_->Serialize(entries[0].first, entries[0].second);
+  } else {
+    staged_log_ = delegate_->SerializeBatch(entries);
+  }
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << entries.size()
+          << " entries starting from " << staged_entry_keys_.front();
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -162,24 +186,26 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
-
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
+  for (const std::string& staged_entry_key : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(staged_entry_key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
+
+    // Update the persistent value.
+    update->SetPath({log_iter->first, kLogSentKey},
+                    base::Value(log_iter->second.sent));
+    update->SetPath({log_iter->first, kLogTimestampKey},
+                    base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(staged_entry_key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
 
-  staged_entry_key_.clear();
+  staged_entry_keys_.clear();
   staged_log_.clear();
 }
 
@@ -35,6 +35,7 @@
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "third_party/metrics_proto/reporting_info.pb.h"
 
@@ -55,6 +56,10 @@ constexpr char kP2AServerUrl[] = "https://p2a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// Delay between the first histogram change and applying all the changes
+// collected by then on UI thread.
+constexpr int64_t kHistogramValuesFlushDelayMs = 500;
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -245,6 +250,7 @@ void BraveP3AService::Init(
 
   // Init log store.
   log_store_.reset(new BraveP3ALogStore(this, local_state_));
+  log_store_->set_max_batch_size(upload_batch_size_);
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
   for (const auto& entry : histogram_values_) {
@@ -305,6 +311,17 @@ std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
   return message.SerializeAsString();
 }
 
+std::string BraveP3AService::SerializeBatch(
+    const std::vector<std::pair<std::string, uint64_t>>& entries) {
+  UpdatePyxisMeta();
+  brave_pyxis::RawP3AValueBatch batch;
+  for (const auto& entry : entries) {
+    prochlo::GenerateP3AMessage(base::HashMetricName(entry.first),
+                                entry.second, pyxis_meta_, batch.add_values());
+  }
+  return batch.SerializeAsString();
+}
+
 bool
 BraveP3AService::IsActualMetric(base::StringPiece histogram_name) const {
   static const base::NoDestructor<base::flat_set<base::StringPiece>>
@@ -338,6 +355,15 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     }
   }
 
+  if (cmdline->HasSwitch(switches::kP3AUploadBatchSize)) {
+    std::string size_str =
+        cmdline->GetSwitchValueASCII(switches::kP3AUploadBatchSize);
+    size_t size;
+    if (base::StringToSizeT(size_str, &size) && size > 0) {
+      upload_batch_size_ = size;
+    }
+  }
+
   if (cmdline->HasSwitch(switches::kP3AUploadServerUrl)) {
     GURL url =
         GURL(cmdline->GetSwitchValueASCII(switches::kP3AUploadServerUrl));
@@ -413,13 +439,8 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
 
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
-  if (IsSuspendedMetric(histogram_name, sample)) {
-    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+  if (sample == kSuspendedMetricValue) {
+    QueueHistogramValue(histogram_name, kSuspendedMetricBucket);
     return;
   }
 
@@ -448,21 +469,43 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
   }
 
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  QueueHistogramValue(histogram_name, bucket);
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
-  if (!initialized_) {
-    // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+void BraveP3AService::QueueHistogramValue(base::StringPiece histogram_name,
+                                          size_t bucket) {
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    pending_histogram_values_[histogram_name] = bucket;
+    if (pending_histogram_values_flush_posted_) {
+      return;
+    }
+    pending_histogram_values_flush_posted_ = true;
+  }
+  content::GetUIThreadTaskRunner({})->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&BraveP3AService::FlushPendingHistogramValues, this),
+      base::TimeDelta::FromMilliseconds(kHistogramValuesFlushDelayMs));
+}
+
+void BraveP3AService::FlushPendingHistogramValues() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  base::flat_map<base::StringPiece, size_t> values;
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    values.swap(pending_histogram_values_);
+    pending_histogram_values_flush_posted_ = false;
+  }
+
+  for (const auto& entry : values) {
+    VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
+            << entry.first << " bucket = " << entry.second;
+    if (!initialized_) {
+      // Will handle it later when ready.
+      histogram_values_[entry.first] = entry.second;
+    } else {
+      HandleHistogramChange(entry.first, entry.second);
+    }
   }
 }
 
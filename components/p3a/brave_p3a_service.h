@@ -8,10 +8,14 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -52,12 +56,16 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) override;
+  std::string SerializeBatch(
+      const std::vector<std::pair<std::string, uint64_t>>& entries) override;
 
   // May be accessed from multiple threads, so this is thread-safe.
   bool IsActualMetric(base::StringPiece histogram_name) const override;
 
  private:
   friend class base::RefCountedThreadSafe<BraveP3AService>;
+  FRIEND_TEST_ALL_PREFIXES(BraveP3AServiceTest, CoalescesHistogramBurst);
+
   ~BraveP3AService() override;
 
   void MaybeOverrideSettingsFromCommandLine();
@@ -70,14 +78,16 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method records the latest bucket of the
+  // histogram and posts a single delayed flush to UI thread.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  void QueueHistogramValue(base::StringPiece histogram_name, size_t bucket);
+
+  // Applies the values collected by |QueueHistogramValue| on UI thread.
+  void FlushPendingHistogramValues();
 
   // Updates or removes a metric from the log.
   void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
@@ -99,6 +109,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // The average interval between uploading different values.
   base::TimeDelta average_upload_interval_;
   bool randomize_upload_interval_ = true;
+  // Maximum number of values of the same type sent in one upload.
+  size_t upload_batch_size_ = 1u;
   // Interval between rotations, only used for testing from the command line.
   base::TimeDelta rotation_interval_;
   GURL upload_server_url_;
@@ -114,6 +126,13 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Latest buckets of the histograms that changed since the last flush to UI
+  // thread. Since only the latest value of a metric is reported, a burst of
+  // samples costs a single UI task.
+  base::Lock pending_histogram_values_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_histogram_values_;
+  bool pending_histogram_values_flush_posted_ = false;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
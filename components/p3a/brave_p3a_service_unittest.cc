@@ -0,0 +1,156 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_service.h"
+
+#include <memory>
+#include <string>
+
+#include "base/base64.h"
+#include "base/command_line.h"
+#include "base/containers/flat_set.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/metrics_hashes.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/test/bind.h"
+#include "base/test/scoped_command_line.h"
+#include "brave/components/brave_prochlo/prochlo_message.pb.h"
+#include "brave/components/brave_referrals/common/pref_names.h"
+#include "brave/components/p3a/brave_p3a_switches.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/data_element.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kFirstHistogram[] = "Brave.Core.TabCount";
+constexpr char kSecondHistogram[] = "Brave.Core.WindowCount.2";
+constexpr char kTestP3AServerUrl[] = "https://p3a.brave.test/";
+
+std::string GetUploadData(const network::ResourceRequest& request) {
+  std::string upload_data;
+  if (!request.request_body) {
+    return {};
+  }
+  for (const network::DataElement& element :
+       *request.request_body->elements()) {
+    if (element.type() == network::mojom::DataElementDataView::Tag::kBytes) {
+      const auto& bytes = element.As<network::DataElementBytes>().bytes();
+      upload_data.append(bytes.begin(), bytes.end());
+    }
+  }
+  return upload_data;
+}
+
+}  // namespace
+
+class BraveP3AServiceTest : public testing::Test {
+ public:
+  BraveP3AServiceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+  void SetUp() override {
+    statistics_recorder_ =
+        base::StatisticsRecorder::CreateTemporaryForTesting();
+
+    base::CommandLine* command_line =
+        scoped_command_line_.GetProcessCommandLine();
+    command_line->AppendSwitch(switches::kP3ADoNotRandomizeUploadInterval);
+    command_line->AppendSwitchASCII(switches::kP3AUploadIntervalSeconds, "1");
+    command_line->AppendSwitchASCII(switches::kP3AUploadBatchSize, "10");
+    command_line->AppendSwitchASCII(switches::kP3AUploadServerUrl,
+                                    kTestP3AServerUrl);
+
+    BraveP3AService::RegisterPrefs(local_state_.registry(), true);
+    local_state_.registry()->RegisterStringPref(kReferralPromoCode,
+                                                std::string());
+
+    service_ = base::MakeRefCounted<BraveP3AService>(&local_state_, "release",
+                                                     "2021-01-04");
+    service_->InitCallbacks();
+  }
+
+ protected:
+  // Records |count| samples alternating between the two test histograms.
+  void RecordSampleBurst(int count) {
+    for (int i = 0; i < count; ++i) {
+      base::UmaHistogramExactLinear(i % 2 ? kSecondHistogram : kFirstHistogram,
+                                    i % 7, 8);
+    }
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  base::test::ScopedCommandLine scoped_command_line_;
+  std::unique_ptr<base::StatisticsRecorder> statistics_recorder_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  TestingPrefServiceSimple local_state_;
+  scoped_refptr<BraveP3AService> service_;
+};
+
+TEST_F(BraveP3AServiceTest, CoalescesHistogramBurst) {
+  const size_t pending_task_count =
+      task_environment_.GetPendingMainThreadTaskCount();
+
+  RecordSampleBurst(100000);
+
+  // The whole burst results in a single task posted to UI thread.
+  EXPECT_EQ(pending_task_count + 1,
+            task_environment_.GetPendingMainThreadTaskCount());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(pending_task_count,
+            task_environment_.GetPendingMainThreadTaskCount());
+
+  // Only the last value of each histogram is kept.
+  EXPECT_EQ(3u, service_->histogram_values_[kFirstHistogram]);
+  EXPECT_EQ(4u, service_->histogram_values_[kSecondHistogram]);
+
+  // Samples recorded after the flush post a new task.
+  RecordSampleBurst(1);
+  EXPECT_EQ(pending_task_count + 1,
+            task_environment_.GetPendingMainThreadTaskCount());
+}
+
+TEST_F(BraveP3AServiceTest, UploadsBatchedPayload) {
+  int request_count = 0;
+  brave_pyxis::RawP3AValueBatch uploaded_batch;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        ASSERT_EQ(GURL(kTestP3AServerUrl), request.url);
+        ++request_count;
+        std::string payload;
+        ASSERT_TRUE(base::Base64Decode(GetUploadData(request), &payload));
+        ASSERT_TRUE(uploaded_batch.ParseFromString(payload));
+      }));
+  url_loader_factory_.AddResponse(kTestP3AServerUrl, std::string());
+
+  RecordSampleBurst(100);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+
+  service_->Init(shared_url_loader_factory_);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(10));
+
+  // All the P3A values fit into a single upload.
+  EXPECT_EQ(1, request_count);
+  ASSERT_GE(uploaded_batch.values_size(), 2);
+  base::flat_set<uint64_t> metric_ids;
+  for (const auto& value : uploaded_batch.values()) {
+    metric_ids.insert(value.metric_id());
+  }
+  EXPECT_TRUE(metric_ids.contains(base::HashMetricName(kFirstHistogram)));
+  EXPECT_TRUE(metric_ids.contains(base::HashMetricName(kSecondHistogram)));
+}
+
+}  // namespace brave
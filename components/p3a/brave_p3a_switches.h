@@ -19,6 +19,9 @@ constexpr char kP3ADoNotRandomizeUploadInterval[] =
 // Interval between restarting the uploading process for all gathered values.
 constexpr char kP3ARotationIntervalSeconds[] = "p3a-rotation-interval-seconds";
 
+// Maximum number of values of the same type sent in one upload.
+constexpr char kP3AUploadBatchSize[] = "p3a-upload-batch-size";
+
 // P3A cloud backend URL.
 constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 
@@ -7,9 +7,11 @@
 
 #include <utility>
 
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "bat/ads/ad_event_history.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
-#include "base/logging.h"
 
 namespace bat_ads {
 
@@ -105,6 +107,11 @@ void BatAdsClientMojoBridge::RecordAdEvent(const std::string& ad_type,
     return;
   }
 
+  const std::string id = ad_type + confirmation_type;
+  if (mirrored_ad_event_ids_.find(id) != mirrored_ad_event_ids_.end()) {
+    ad_event_history_.Record(ad_type, confirmation_type, timestamp);
+  }
+
   bat_ads_client_->RecordAdEvent(ad_type, confirmation_type, timestamp);
 }
 
@@ -115,9 +122,19 @@ std::vector<uint64_t> BatAdsClientMojoBridge::GetAdEvents(
     return {};
   }
 
-  std::vector<uint64_t> ad_events;
-  bat_ads_client_->GetAdEvents(ad_type, confirmation_type, &ad_events);
-  return ad_events;
+  const std::string id = ad_type + confirmation_type;
+  if (mirrored_ad_event_ids_.find(id) == mirrored_ad_event_ids_.end()) {
+    std::vector<uint64_t> ad_events;
+    bat_ads_client_->GetAdEvents(ad_type, confirmation_type, &ad_events);
+
+    for (const auto timestamp : ad_events) {
+      ad_event_history_.Record(ad_type, confirmation_type, timestamp);
+    }
+
+    mirrored_ad_event_ids_.insert(id);
+  }
+
+  return ad_event_history_.Get(ad_type, confirmation_type);
 }
 
 void OnUrlRequest(
@@ -240,6 +257,11 @@ void BatAdsClientMojoBridge::Load(
 
 std::string BatAdsClientMojoBridge::LoadResourceForId(
     const std::string& id) {
+  const auto iter = resources_.find(id);
+  if (iter != resources_.end()) {
+    return iter->second;
+  }
+
   std::string value;
 
   if (!connected()) {
@@ -247,6 +269,10 @@ std::string BatAdsClientMojoBridge::LoadResourceForId(
   }
 
   bat_ads_client_->LoadResourceForId(id, &value);
+  if (!value.empty()) {
+    resources_.insert({id, value});
+  }
+
   return value;
 }
 
@@ -285,6 +311,11 @@ void BatAdsClientMojoBridge::Log(
 
 bool BatAdsClientMojoBridge::GetBooleanPref(
     const std::string& path) const {
+  const base::Value* pref = FindPref(path);
+  if (pref && pref->is_bool()) {
+    return pref->GetBool();
+  }
+
   bool value = false;
 
   if (!connected()) {
@@ -292,6 +323,7 @@ bool BatAdsClientMojoBridge::GetBooleanPref(
   }
 
   bat_ads_client_->GetBooleanPref(path, &value);
+  SetPref(path, base::Value(value));
   return value;
 }
 
@@ -302,11 +334,17 @@ void BatAdsClientMojoBridge::SetBooleanPref(
     return;
   }
 
+  WritePref(path, base::Value(value));
   bat_ads_client_->SetBooleanPref(path, value);
 }
 
 int BatAdsClientMojoBridge::GetIntegerPref(
     const std::string& path) const {
+  const base::Value* pref = FindPref(path);
+  if (pref && pref->is_int()) {
+    return pref->GetInt();
+  }
+
   int value = 0;
 
   if (!connected()) {
@@ -314,6 +352,7 @@ int BatAdsClientMojoBridge::GetIntegerPref(
   }
 
   bat_ads_client_->GetIntegerPref(path, &value);
+  SetPref(path, base::Value(value));
   return value;
 }
 
@@ -324,11 +363,17 @@ void BatAdsClientMojoBridge::SetIntegerPref(
     return;
   }
 
+  WritePref(path, base::Value(value));
   bat_ads_client_->SetIntegerPref(path, value);
 }
 
 double BatAdsClientMojoBridge::GetDoublePref(
     const std::string& path) const {
+  const base::Value* pref = FindPref(path);
+  if (pref && (pref->is_double() || pref->is_int())) {
+    return pref->GetDouble();
+  }
+
   double value = 0.0;
 
   if (!connected()) {
@@ -336,6 +381,7 @@ double BatAdsClientMojoBridge::GetDoublePref(
   }
 
   bat_ads_client_->GetDoublePref(path, &value);
+  SetPref(path, base::Value(value));
   return value;
 }
 
@@ -346,11 +392,17 @@ void BatAdsClientMojoBridge::SetDoublePref(
     return;
   }
 
+  WritePref(path, base::Value(value));
   bat_ads_client_->SetDoublePref(path, value);
 }
 
 std::string BatAdsClientMojoBridge::GetStringPref(
     const std::string& path) const {
+  const base::Value* pref = FindPref(path);
+  if (pref && pref->is_string()) {
+    return pref->GetString();
+  }
+
   std::string value;
 
   if (!connected()) {
@@ -358,6 +410,7 @@ std::string BatAdsClientMojoBridge::GetStringPref(
   }
 
   bat_ads_client_->GetStringPref(path, &value);
+  SetPref(path, base::Value(value));
   return value;
 }
 
@@ -368,11 +421,19 @@ void BatAdsClientMojoBridge::SetStringPref(
     return;
   }
 
+  WritePref(path, base::Value(value));
   bat_ads_client_->SetStringPref(path, value);
 }
 
 int64_t BatAdsClientMojoBridge::GetInt64Pref(
     const std::string& path) const {
+  const base::Value* pref = FindPref(path);
+  int64_t mirrored_value;
+  if (pref && pref->is_string() &&
+      base::StringToInt64(pref->GetString(), &mirrored_value)) {
+    return mirrored_value;
+  }
+
   int64_t value = 0;
 
   if (!connected()) {
@@ -380,6 +441,7 @@ int64_t BatAdsClientMojoBridge::GetInt64Pref(
   }
 
   bat_ads_client_->GetInt64Pref(path, &value);
+  SetPref(path, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -390,11 +452,19 @@ void BatAdsClientMojoBridge::SetInt64Pref(
     return;
   }
 
+  WritePref(path, base::Value(base::NumberToString(value)));
   bat_ads_client_->SetInt64Pref(path, value);
 }
 
 uint64_t BatAdsClientMojoBridge::GetUint64Pref(
     const std::string& path) const {
+  const base::Value* pref = FindPref(path);
+  uint64_t mirrored_value;
+  if (pref && pref->is_string() &&
+      base::StringToUint64(pref->GetString(), &mirrored_value)) {
+    return mirrored_value;
+  }
+
   uint64_t value = 0;
 
   if (!connected()) {
@@ -402,6 +472,7 @@ uint64_t BatAdsClientMojoBridge::GetUint64Pref(
   }
 
   bat_ads_client_->GetUint64Pref(path, &value);
+  SetPref(path, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -412,6 +483,7 @@ void BatAdsClientMojoBridge::SetUint64Pref(
     return;
   }
 
+  WritePref(path, base::Value(base::NumberToString(value)));
   bat_ads_client_->SetUint64Pref(path, value);
 }
 
@@ -421,13 +493,63 @@ void BatAdsClientMojoBridge::ClearPref(
     return;
   }
 
+  // The default value is only known to the browser, which reports it back
+  // through |OnPrefChanged|. Until then reads fall back to a sync call
+  prefs_.erase(path);
   bat_ads_client_->ClearPref(path);
 }
 
+void BatAdsClientMojoBridge::SetPrefs(
+    base::flat_map<std::string, base::Value> prefs) {
+  for (auto& pref : prefs) {
+    prefs_.insert({pref.first, std::move(pref.second)});
+  }
+}
+
+void BatAdsClientMojoBridge::OnPrefChanged(
+    const std::string& path,
+    base::Value value) {
+  // The browser reports back every write made from this process, so a change
+  // reported while writes are pending is superseded by the mirrored value
+  const auto iter = pending_pref_writes_.find(path);
+  if (iter != pending_pref_writes_.end()) {
+    if (--iter->second == 0) {
+      pending_pref_writes_.erase(iter);
+    }
+
+    return;
+  }
+
+  SetPref(path, std::move(value));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+const base::Value* BatAdsClientMojoBridge::FindPref(
+    const std::string& path) const {
+  const auto iter = prefs_.find(path);
+  if (iter == prefs_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void BatAdsClientMojoBridge::SetPref(
+    const std::string& path,
+    base::Value value) const {
+  prefs_.insert_or_assign(path, std::move(value));
+}
+
+void BatAdsClientMojoBridge::WritePref(
+    const std::string& path,
+    base::Value value) {
+  SetPref(path, std::move(value));
+  pending_pref_writes_[path]++;
+}
+
 }  // namespace bat_ads
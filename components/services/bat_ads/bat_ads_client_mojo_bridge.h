@@ -7,9 +7,13 @@
 #define BRAVE_COMPONENTS_SERVICES_BAT_ADS_BAT_ADS_CLIENT_MOJO_BRIDGE_H_
 
 #include <cstdint>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/values.h"
+#include "bat/ads/ad_event_history.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -133,10 +137,49 @@ class BatAdsClientMojoBridge
   void ClearPref(
       const std::string& path) override;
 
+  // Seeds the mirror with the ads prefs pushed by the browser at startup.
+  // Prefs which are already mirrored are at least as recent, so are kept
+  void SetPrefs(
+      base::flat_map<std::string, base::Value> prefs);
+
+  // Updates the mirrored value of |path| after it was changed in the browser
+  void OnPrefChanged(
+      const std::string& path,
+      base::Value value);
+
  private:
   bool connected() const;
 
+  const base::Value* FindPref(
+      const std::string& path) const;
+  void SetPref(
+      const std::string& path,
+      base::Value value) const;
+  void WritePref(
+      const std::string& path,
+      base::Value value);
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  // Mirror of the prefs read or written by the ads library, so that reads are
+  // served locally instead of blocking on a sync call to the browser. Entries
+  // are added on first read, updated on write and replaced whenever the
+  // browser reports a change. 64-bit integers are stored as strings, the same
+  // as in the browser
+  mutable base::flat_map<std::string, base::Value> prefs_;
+
+  // Number of writes to each pref which the browser has not reported back
+  // yet. Changes reported before then are older than the mirrored value
+  base::flat_map<std::string, int> pending_pref_writes_;
+
+  // Ad events are only recorded by the ads library, so once the history of an
+  // ad and confirmation type has been read from the browser it is kept up to
+  // date locally
+  mutable ads::AdEventHistory ad_event_history_;
+  mutable std::set<std::string> mirrored_ad_event_ids_;
+
+  // Resources are compiled into the browser, so never change once loaded
+  base::flat_map<std::string, std::string> resources_;
 };
 
 }  // namespace bat_ads
@@ -0,0 +1,228 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/pref_names.h"
+#include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAdsClientMojoBridgeTest.*
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace bat_ads {
+
+// Serves the browser side of the client interface from its own thread, the
+// same as the browser does for the ads utility process, so that sync calls
+// made by the bridge can be answered and counted
+class BatAdsClientMojoBridgeTest : public testing::Test {
+ public:
+  BatAdsClientMojoBridgeTest() : browser_thread_("BatAdsClientBrowser") {}
+
+  void SetUp() override {
+    ASSERT_TRUE(browser_thread_.Start());
+
+    mojo::AssociatedRemote<mojom::BatAdsClient> remote;
+    browser_thread_.task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&BatAdsClientMojoBridgeTest::BindOnBrowserThread,
+                       base::Unretained(this),
+                       remote.BindNewEndpointAndPassDedicatedReceiver()));
+
+    bridge_ = std::make_unique<BatAdsClientMojoBridge>(remote.Unbind());
+  }
+
+  void TearDown() override {
+    bridge_.reset();
+
+    browser_thread_.task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&BatAdsClientMojoBridgeTest::ResetOnBrowserThread,
+                       base::Unretained(this)));
+    browser_thread_.Stop();
+  }
+
+ protected:
+  // Mojo keeps messages on a pipe in order, so a sync call returning means
+  // that all previous async writes have reached the browser
+  void FlushWrites() {
+    EXPECT_CALL(ads_client_mock_, IsForeground()).WillOnce(Return(true));
+    bridge_->IsForeground();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  NiceMock<ads::AdsClientMock> ads_client_mock_;
+  std::unique_ptr<BatAdsClientMojoBridge> bridge_;
+
+ private:
+  void BindOnBrowserThread(
+      mojo::PendingAssociatedReceiver<mojom::BatAdsClient> receiver) {
+    ads_client_ = std::make_unique<AdsClientMojoBridge>(&ads_client_mock_);
+    receiver_ =
+        std::make_unique<mojo::AssociatedReceiver<mojom::BatAdsClient>>(
+            ads_client_.get(), std::move(receiver));
+  }
+
+  void ResetOnBrowserThread() {
+    receiver_.reset();
+    ads_client_.reset();
+  }
+
+  base::Thread browser_thread_;
+  std::unique_ptr<AdsClientMojoBridge> ads_client_;
+  std::unique_ptr<mojo::AssociatedReceiver<mojom::BatAdsClient>> receiver_;
+};
+
+TEST_F(BatAdsClientMojoBridgeTest, ReadPrefOnceFromBrowser) {
+  EXPECT_CALL(ads_client_mock_, GetBooleanPref(ads::prefs::kEnabled))
+      .WillOnce(Return(true));
+
+  EXPECT_TRUE(bridge_->GetBooleanPref(ads::prefs::kEnabled));
+  EXPECT_TRUE(bridge_->GetBooleanPref(ads::prefs::kEnabled));
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ServeWrittenPrefLocally) {
+  EXPECT_CALL(ads_client_mock_, GetInt64Pref).Times(0);
+  EXPECT_CALL(ads_client_mock_, SetInt64Pref(ads::prefs::kAdsPerHour, 5));
+
+  bridge_->SetInt64Pref(ads::prefs::kAdsPerHour, 5);
+  EXPECT_EQ(5, bridge_->GetInt64Pref(ads::prefs::kAdsPerHour));
+
+  FlushWrites();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, IgnoreStaleChangeForWrittenPref) {
+  EXPECT_CALL(ads_client_mock_, GetInt64Pref).Times(0);
+
+  bridge_->SetInt64Pref(ads::prefs::kAdsPerHour, 2);
+  bridge_->SetInt64Pref(ads::prefs::kAdsPerHour, 5);
+
+  // The browser reports each write back once it has been applied
+  bridge_->OnPrefChanged(ads::prefs::kAdsPerHour, base::Value("2"));
+  EXPECT_EQ(5, bridge_->GetInt64Pref(ads::prefs::kAdsPerHour));
+
+  bridge_->OnPrefChanged(ads::prefs::kAdsPerHour, base::Value("5"));
+  EXPECT_EQ(5, bridge_->GetInt64Pref(ads::prefs::kAdsPerHour));
+
+  // Changes made by the browser are mirrored once all writes are reported
+  bridge_->OnPrefChanged(ads::prefs::kAdsPerHour, base::Value("1"));
+  EXPECT_EQ(1, bridge_->GetInt64Pref(ads::prefs::kAdsPerHour));
+
+  FlushWrites();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ServeInitialPrefsLocally) {
+  EXPECT_CALL(ads_client_mock_, GetBooleanPref).Times(0);
+  EXPECT_CALL(ads_client_mock_, GetInt64Pref).Times(0);
+
+  bridge_->SetInt64Pref(ads::prefs::kAdsPerHour, 5);
+
+  base::flat_map<std::string, base::Value> prefs;
+  prefs.insert({ads::prefs::kEnabled, base::Value(true)});
+  prefs.insert({ads::prefs::kAdsPerHour, base::Value("2")});
+  bridge_->SetPrefs(std::move(prefs));
+
+  EXPECT_TRUE(bridge_->GetBooleanPref(ads::prefs::kEnabled));
+  EXPECT_EQ(5, bridge_->GetInt64Pref(ads::prefs::kAdsPerHour));
+
+  FlushWrites();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ServeChangedPrefLocally) {
+  EXPECT_CALL(ads_client_mock_, GetBooleanPref).Times(0);
+  EXPECT_CALL(ads_client_mock_, GetUint64Pref).Times(0);
+
+  bridge_->OnPrefChanged(ads::prefs::kEnabled, base::Value(false));
+  bridge_->OnPrefChanged(ads::prefs::kCatalogLastUpdated,
+                         base::Value("18446744073709551615"));
+
+  EXPECT_FALSE(bridge_->GetBooleanPref(ads::prefs::kEnabled));
+  EXPECT_EQ(18446744073709551615ULL,
+            bridge_->GetUint64Pref(ads::prefs::kCatalogLastUpdated));
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ReadClearedPrefFromBrowser) {
+  EXPECT_CALL(ads_client_mock_, ClearPref(ads::prefs::kCatalogId));
+  EXPECT_CALL(ads_client_mock_, GetStringPref(ads::prefs::kCatalogId))
+      .WillOnce(Return(""));
+
+  bridge_->SetStringPref(ads::prefs::kCatalogId, "catalog");
+  bridge_->ClearPref(ads::prefs::kCatalogId);
+
+  EXPECT_EQ("", bridge_->GetStringPref(ads::prefs::kCatalogId));
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, SyncCallsDuringAdServing) {
+  // Each pref read by the ads library while serving ads should cost one sync
+  // call per session rather than one per read
+  EXPECT_CALL(ads_client_mock_, GetBooleanPref(ads::prefs::kEnabled))
+      .WillOnce(Return(true));
+  EXPECT_CALL(ads_client_mock_, GetInt64Pref(ads::prefs::kAdsPerHour))
+      .WillOnce(Return(2));
+  EXPECT_CALL(ads_client_mock_, GetIntegerPref(ads::prefs::kIdleTimeThreshold))
+      .WillOnce(Return(15));
+  EXPECT_CALL(ads_client_mock_,
+              GetStringPref(ads::prefs::kEpsilonGreedyBanditArms))
+      .WillOnce(Return("{}"));
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(bridge_->GetBooleanPref(ads::prefs::kEnabled));
+    ASSERT_EQ(2, bridge_->GetInt64Pref(ads::prefs::kAdsPerHour));
+    ASSERT_EQ(15, bridge_->GetIntegerPref(ads::prefs::kIdleTimeThreshold));
+    bridge_->GetStringPref(ads::prefs::kEpsilonGreedyBanditArms);
+    bridge_->SetStringPref(ads::prefs::kEpsilonGreedyBanditArms,
+                           std::to_string(i));
+  }
+
+  EXPECT_EQ("99", bridge_->GetStringPref(ads::prefs::kEpsilonGreedyBanditArms));
+
+  FlushWrites();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ReadAdEventsOnceFromBrowser) {
+  const uint64_t timestamp =
+      static_cast<uint64_t>(base::Time::Now().ToDoubleT());
+
+  EXPECT_CALL(ads_client_mock_, GetAdEvents("ad_notification", "viewed"))
+      .WillOnce(Return(std::vector<uint64_t>{timestamp}));
+  EXPECT_CALL(ads_client_mock_,
+              RecordAdEvent("ad_notification", "viewed", timestamp + 1));
+
+  EXPECT_EQ(std::vector<uint64_t>({timestamp}),
+            bridge_->GetAdEvents("ad_notification", "viewed"));
+
+  bridge_->RecordAdEvent("ad_notification", "viewed", timestamp + 1);
+
+  EXPECT_EQ(std::vector<uint64_t>({timestamp, timestamp + 1}),
+            bridge_->GetAdEvents("ad_notification", "viewed"));
+
+  FlushWrites();
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, LoadResourceOnceFromBrowser) {
+  EXPECT_CALL(ads_client_mock_, LoadResourceForId("resource"))
+      .WillOnce(Return("value"));
+
+  EXPECT_EQ("value", bridge_->LoadResourceForId("resource"));
+  EXPECT_EQ("value", bridge_->LoadResourceForId("resource"));
+}
+
+}  // namespace bat_ads
@@ -45,7 +45,10 @@ BatAdsImpl::BatAdsImpl(
 BatAdsImpl::~BatAdsImpl() = default;
 
 void BatAdsImpl::Initialize(
+    base::flat_map<std::string, base::Value> prefs,
     InitializeCallback callback) {
+  bat_ads_client_mojo_proxy_->SetPrefs(std::move(prefs));
+
   auto* holder = new CallbackHolder<InitializeCallback>(AsWeakPtr(),
       std::move(callback));
 
@@ -66,10 +69,22 @@ void BatAdsImpl::ChangeLocale(
   ads_->ChangeLocale(locale);
 }
 
-void BatAdsImpl::OnPrefChanged(const std::string& path) {
+void BatAdsImpl::OnPrefChanged(const std::string& path, base::Value value) {
+  bat_ads_client_mojo_proxy_->OnPrefChanged(path, std::move(value));
   ads_->OnPrefChanged(path);
 }
 
+void BatAdsImpl::ShouldLoadPageContent(
+    const std::vector<std::string>& redirect_chain,
+    ShouldLoadPageContentCallback callback) {
+  auto* holder = new CallbackHolder<ShouldLoadPageContentCallback>(
+      AsWeakPtr(), std::move(callback));
+
+  ads_->ShouldLoadPageContent(
+      redirect_chain,
+      std::bind(BatAdsImpl::OnShouldLoadPageContent, holder, _1, _2));
+}
+
 void BatAdsImpl::OnHtmlLoaded(const int32_t tab_id,
                               const std::vector<std::string>& redirect_chain,
                               const std::string& html) {
@@ -288,6 +303,17 @@ void BatAdsImpl::OnRemoveAllHistory(
   delete holder;
 }
 
+void BatAdsImpl::OnShouldLoadPageContent(
+    CallbackHolder<ShouldLoadPageContentCallback>* holder,
+    const bool should_load_html,
+    const bool should_load_text) {
+  if (holder->is_valid()) {
+    std::move(holder->get()).Run(should_load_html, should_load_text);
+  }
+
+  delete holder;
+}
+
 void BatAdsImpl::OnGetAccountStatement(
     CallbackHolder<GetAccountStatementCallback>* holder,
     const bool success,
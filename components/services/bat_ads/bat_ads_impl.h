@@ -12,7 +12,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "bat/ads/ads.h"
@@ -39,6 +41,7 @@ class BatAdsImpl :
 
   // Overridden from mojom::BatAds:
   void Initialize(
+      base::flat_map<std::string, base::Value> prefs,
       InitializeCallback callback) override;
   void Shutdown(
       ShutdownCallback callback) override;
@@ -46,7 +49,10 @@ class BatAdsImpl :
   void ChangeLocale(
       const std::string& locale) override;
 
-  void OnPrefChanged(const std::string& path) override;
+  void OnPrefChanged(const std::string& path, base::Value value) override;
+
+  void ShouldLoadPageContent(const std::vector<std::string>& redirect_chain,
+                             ShouldLoadPageContentCallback callback) override;
 
   void OnHtmlLoaded(const int32_t tab_id,
                     const std::vector<std::string>& redirect_chain,
@@ -177,6 +183,11 @@ class BatAdsImpl :
       CallbackHolder<RemoveAllHistoryCallback>* holder,
       const int32_t result);
 
+  static void OnShouldLoadPageContent(
+      CallbackHolder<ShouldLoadPageContentCallback>* holder,
+      const bool should_load_html,
+      const bool should_load_text);
+
   static void OnGetAccountStatement(
       CallbackHolder<GetAccountStatementCallback>* holder,
       const bool success,
@@ -10,16 +10,51 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
+#include "net/base/escape.h"
 
 namespace bat_ledger {
 
+namespace {
+
+ledger::type::DBCommandResponsePtr RunDBTransactionOnDatabaseTaskRunner(
+    ledger::type::DBTransactionPtr transaction,
+    ledger::LedgerDatabase* database) {
+  auto response = ledger::type::DBCommandResponse::New();
+  if (!database) {
+    response->status = ledger::type::DBCommandResponse::Status::RESPONSE_ERROR;
+  } else {
+    database->RunTransaction(std::move(transaction), response.get());
+  }
+
+  return response;
+}
+
+}  // namespace
+
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info) {
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path) {
   bat_ledger_client_.Bind(std::move(client_info));
+
+  if (!database_path.empty()) {
+    database_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+    database_.reset(ledger::LedgerDatabase::CreateInstance(database_path));
+  }
 }
 
-BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() = default;
+BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() {
+  if (database_) {
+    database_task_runner_->DeleteSoon(FROM_HERE, database_.release());
+  }
+}
 
 void OnLoadURL(
     const ledger::client::LoadURLCallback& callback,
@@ -131,12 +166,7 @@ void BatLedgerClientMojoBridge::FetchFavIcon(const std::string& url,
 }
 
 std::string BatLedgerClientMojoBridge::URIEncode(const std::string& value) {
-  if (!Connected())
-    return "";
-
-  std::string encoded_value;
-  bat_ledger_client_->URIEncode(value, &encoded_value);
-  return encoded_value;
+  return net::EscapeQueryParamValue(value, false);
 }
 
 void BatLedgerClientMojoBridge::PublisherListNormalized(
@@ -150,123 +180,235 @@ void BatLedgerClientMojoBridge::PublisherListNormalized(
 
 void BatLedgerClientMojoBridge::SetBooleanState(const std::string& name,
                                                bool value) {
+  MirrorState(name, base::Value(value));
   bat_ledger_client_->SetBooleanState(name, value);
 }
 
 bool BatLedgerClientMojoBridge::GetBooleanState(const std::string& name) const {
+  const base::Value* state = FindState(name);
+  if (state && state->is_bool())
+    return state->GetBool();
+
   bool value;
   bat_ledger_client_->GetBooleanState(name, &value);
+  MirrorState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetIntegerState(const std::string& name,
                                                int value) {
+  MirrorState(name, base::Value(value));
   bat_ledger_client_->SetIntegerState(name, value);
 }
 
 int BatLedgerClientMojoBridge::GetIntegerState(const std::string& name) const {
+  const base::Value* state = FindState(name);
+  if (state && state->is_int())
+    return state->GetInt();
+
   int value;
   bat_ledger_client_->GetIntegerState(name, &value);
+  MirrorState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetDoubleState(const std::string& name,
                                               double value) {
+  MirrorState(name, base::Value(value));
   bat_ledger_client_->SetDoubleState(name, value);
 }
 
 double BatLedgerClientMojoBridge::GetDoubleState(
     const std::string& name) const {
+  const base::Value* state = FindState(name);
+  if (state && (state->is_double() || state->is_int()))
+    return state->GetDouble();
+
   double value;
   bat_ledger_client_->GetDoubleState(name, &value);
+  MirrorState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetStringState(const std::string& name,
                               const std::string& value) {
+  MirrorState(name, base::Value(value));
   bat_ledger_client_->SetStringState(name, value);
 }
 
 std::string BatLedgerClientMojoBridge::
 GetStringState(const std::string& name) const {
+  const base::Value* state = FindState(name);
+  if (state && state->is_string())
+    return state->GetString();
+
   std::string value;
   bat_ledger_client_->GetStringState(name, &value);
+  MirrorState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetInt64State(const std::string& name,
                                              int64_t value) {
+  MirrorState(name, base::Value(base::NumberToString(value)));
   bat_ledger_client_->SetInt64State(name, value);
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64State(
     const std::string& name) const {
+  const base::Value* state = FindState(name);
+  int64_t mirrored_value;
+  if (state && state->is_string() &&
+      base::StringToInt64(state->GetString(), &mirrored_value))
+    return mirrored_value;
+
   int64_t value;
   bat_ledger_client_->GetInt64State(name, &value);
+  MirrorState(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetUint64State(const std::string& name,
                                               uint64_t value) {
+  MirrorState(name, base::Value(base::NumberToString(value)));
   bat_ledger_client_->SetUint64State(name, value);
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64State(
     const std::string& name) const {
+  const base::Value* state = FindState(name);
+  uint64_t mirrored_value;
+  if (state && state->is_string() &&
+      base::StringToUint64(state->GetString(), &mirrored_value))
+    return mirrored_value;
+
   uint64_t value;
   bat_ledger_client_->GetUint64State(name, &value);
+  MirrorState(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 void BatLedgerClientMojoBridge::ClearState(const std::string& name) {
+  // The default value is only known to the browser, so the next read falls
+  // back to a sync call
+  state_.erase(name);
   bat_ledger_client_->ClearState(name);
 }
 
 bool BatLedgerClientMojoBridge::GetBooleanOption(
     const std::string& name) const {
+  const base::Value* option = FindOption(name);
+  if (option && option->is_bool())
+    return option->GetBool();
+
   bool value;
   bat_ledger_client_->GetBooleanOption(name, &value);
+  MirrorOption(name, base::Value(value));
   return value;
 }
 
 int BatLedgerClientMojoBridge::GetIntegerOption(const std::string& name) const {
+  const base::Value* option = FindOption(name);
+  if (option && option->is_int())
+    return option->GetInt();
+
   int value;
   bat_ledger_client_->GetIntegerOption(name, &value);
+  MirrorOption(name, base::Value(value));
   return value;
 }
 
 double BatLedgerClientMojoBridge::GetDoubleOption(
     const std::string& name) const {
+  const base::Value* option = FindOption(name);
+  if (option && option->is_double())
+    return option->GetDouble();
+
   double value;
   bat_ledger_client_->GetDoubleOption(name, &value);
+  MirrorOption(name, base::Value(value));
   return value;
 }
 
 std::string BatLedgerClientMojoBridge::GetStringOption(
     const std::string& name) const {
+  const base::Value* option = FindOption(name);
+  if (option && option->is_string())
+    return option->GetString();
+
   std::string value;
   bat_ledger_client_->GetStringOption(name, &value);
+  MirrorOption(name, base::Value(value));
   return value;
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64Option(
     const std::string& name) const {
+  const base::Value* option = FindOption(name);
+  int64_t mirrored_value;
+  if (option && option->is_string() &&
+      base::StringToInt64(option->GetString(), &mirrored_value))
+    return mirrored_value;
+
   int64_t value;
   bat_ledger_client_->GetInt64Option(name, &value);
+  MirrorOption(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64Option(
     const std::string& name) const {
+  const base::Value* option = FindOption(name);
+  uint64_t mirrored_value;
+  if (option && option->is_string() &&
+      base::StringToUint64(option->GetString(), &mirrored_value))
+    return mirrored_value;
+
   uint64_t value;
   bat_ledger_client_->GetUint64Option(name, &value);
+  MirrorOption(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
+void BatLedgerClientMojoBridge::SetState(
+    base::flat_map<std::string, base::Value> state) {
+  for (auto& item : state) {
+    state_.insert({item.first, std::move(item.second)});
+  }
+}
+
 bool BatLedgerClientMojoBridge::Connected() const {
   return bat_ledger_client_.is_bound();
 }
 
+const base::Value* BatLedgerClientMojoBridge::FindState(
+    const std::string& name) const {
+  const auto iter = state_.find(name);
+  if (iter == state_.end())
+    return nullptr;
+
+  return &iter->second;
+}
+
+void BatLedgerClientMojoBridge::MirrorState(const std::string& name,
+                                            base::Value value) const {
+  state_.insert_or_assign(name, std::move(value));
+}
+
+const base::Value* BatLedgerClientMojoBridge::FindOption(
+    const std::string& name) const {
+  const auto iter = options_.find(name);
+  if (iter == options_.end())
+    return nullptr;
+
+  return &iter->second;
+}
+
+void BatLedgerClientMojoBridge::MirrorOption(const std::string& name,
+                                             base::Value value) const {
+  options_.insert_or_assign(name, std::move(value));
+}
+
 void BatLedgerClientMojoBridge::OnContributeUnverifiedPublishers(
       ledger::type::Result result,
       const std::string& publisher_key,
@@ -326,11 +468,53 @@ void OnRunDBTransaction(
 void BatLedgerClientMojoBridge::RunDBTransaction(
     ledger::type::DBTransactionPtr transaction,
     ledger::client::RunDBTransactionCallback callback) {
+  if (database_task_runner_) {
+    // |database_| is deleted on |database_task_runner_|, so it outlives any
+    // transaction posted before it
+    base::PostTaskAndReplyWithResult(
+        database_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&RunDBTransactionOnDatabaseTaskRunner,
+                       std::move(transaction), database_.get()),
+        base::BindOnce(&BatLedgerClientMojoBridge::OnRunDBTransactionInProcess,
+                       AsWeakPtr(), std::move(callback)));
+    return;
+  }
+
   bat_ledger_client_->RunDBTransaction(
       std::move(transaction),
       base::BindOnce(&OnRunDBTransaction, std::move(callback)));
 }
 
+void BatLedgerClientMojoBridge::OnRunDBTransactionInProcess(
+    ledger::client::RunDBTransactionCallback callback,
+    ledger::type::DBCommandResponsePtr response) {
+  callback(std::move(response));
+}
+
+void BatLedgerClientMojoBridge::CloseDatabase(base::OnceClosure callback) {
+  if (!database_) {
+    std::move(callback).Run();
+    return;
+  }
+
+  database_task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::BindOnce(
+          base::DoNothing::Once<std::unique_ptr<ledger::LedgerDatabase>>(),
+          std::move(database_)),
+      std::move(callback));
+}
+
+void BatLedgerClientMojoBridge::SetDatabaseForTesting(
+    std::unique_ptr<ledger::LedgerDatabase> database) {
+  DCHECK(database_task_runner_);
+  if (database_) {
+    database_task_runner_->DeleteSoon(FROM_HERE, database_.release());
+  }
+
+  database_ = std::move(database);
+}
+
 void OnGetCreateScript(
     const ledger::client::GetCreateScriptCallback& callback,
     const std::string& script,
@@ -373,6 +557,10 @@ void BatLedgerClientMojoBridge::DeleteLog(
 bool BatLedgerClientMojoBridge::SetEncryptedStringState(
     const std::string& name,
     const std::string& value) {
+  // Encrypted state shares its pref with the plain string state of the same
+  // name, which is read back from the browser after this
+  state_.erase(name);
+
   bool success;
   bat_ledger_client_->SetEncryptedStringState(name, value, &success);
   return success;
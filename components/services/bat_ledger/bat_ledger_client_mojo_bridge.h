@@ -11,8 +11,15 @@
 #include <string>
 #include <vector>
 
+#include "base/callback_forward.h"
+#include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/values.h"
 #include "bat/ledger/ledger_client.h"
+#include "bat/ledger/ledger_database.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
@@ -23,8 +30,11 @@ class BatLedgerClientMojoBridge :
     public ledger::LedgerClient,
     public base::SupportsWeakPtr<BatLedgerClientMojoBridge>{
  public:
+  // Database transactions are run against |database_path| from this process
+  // unless it is empty, in which case they are sent to the client
   BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path);
   ~BatLedgerClientMojoBridge() override;
 
   BatLedgerClientMojoBridge(const BatLedgerClientMojoBridge&) = delete;
@@ -124,10 +134,42 @@ class BatLedgerClientMojoBridge :
 
   std::string GetEncryptedStringState(const std::string& name) override;
 
+  // Closes the database opened from this process, if any, and runs |callback|
+  // once its files are no longer in use
+  void CloseDatabase(base::OnceClosure callback);
+
+  // Seeds the state mirror with the ledger state pushed by the browser at
+  // startup. State which is already mirrored is at least as recent, so is kept
+  void SetState(base::flat_map<std::string, base::Value> state);
+
+  void SetDatabaseForTesting(std::unique_ptr<ledger::LedgerDatabase> database);
+
  private:
   bool Connected() const;
 
+  const base::Value* FindState(const std::string& name) const;
+  void MirrorState(const std::string& name, base::Value value) const;
+
+  const base::Value* FindOption(const std::string& name) const;
+  void MirrorOption(const std::string& name, base::Value value) const;
+
+  void OnRunDBTransactionInProcess(
+      ledger::client::RunDBTransactionCallback callback,
+      ledger::type::DBCommandResponsePtr response);
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+
+  scoped_refptr<base::SequencedTaskRunner> database_task_runner_;
+  std::unique_ptr<ledger::LedgerDatabase> database_;
+
+  // Mirror of the ledger state, so that reads are served locally instead of
+  // blocking on a sync call to the browser. Only the ledger writes its state
+  // while it is running, so entries are added on first read and updated on
+  // write. 64-bit integers are stored as strings, the same as in the browser
+  mutable base::flat_map<std::string, base::Value> state_;
+
+  // Options are fixed for the lifetime of the ledger
+  mutable base::flat_map<std::string, base::Value> options_;
 };
 
 }  // namespace bat_ledger
@@ -0,0 +1,207 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/bat_ledger_client_mojo_bridge.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "bat/ledger/ledger_database.h"
+#include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerClientMojoBridgeTest.*
+
+namespace bat_ledger {
+
+namespace {
+
+// Records the transactions it runs and when it is deleted, so that tests can
+// tell whether the database is still in use when the bridge replies
+class FakeLedgerDatabase : public ledger::LedgerDatabase {
+ public:
+  FakeLedgerDatabase(int* transaction_count, bool* deleted)
+      : transaction_count_(transaction_count), deleted_(deleted) {}
+
+  ~FakeLedgerDatabase() override { *deleted_ = true; }
+
+  void RunTransaction(
+      ledger::type::DBTransactionPtr transaction,
+      ledger::type::DBCommandResponse* command_response) override {
+    (*transaction_count_)++;
+    command_response->status =
+        ledger::type::DBCommandResponse::Status::RESPONSE_OK;
+  }
+
+ private:
+  int* transaction_count_;  // NOT OWNED
+  bool* deleted_;  // NOT OWNED
+};
+
+ledger::type::DBTransactionPtr CreateTransaction() {
+  auto transaction = ledger::type::DBTransaction::New();
+
+  auto create = ledger::type::DBCommand::New();
+  create->type = ledger::type::DBCommand::Type::EXECUTE;
+  create->command = "CREATE TABLE IF NOT EXISTS test (value INTEGER)";
+  transaction->commands.push_back(std::move(create));
+
+  auto insert = ledger::type::DBCommand::New();
+  insert->type = ledger::type::DBCommand::Type::RUN;
+  insert->command = "INSERT INTO test (value) VALUES (1)";
+  transaction->commands.push_back(std::move(insert));
+
+  auto read = ledger::type::DBCommand::New();
+  read->type = ledger::type::DBCommand::Type::READ;
+  read->command = "SELECT value FROM test";
+  read->record_bindings = {
+      ledger::type::DBCommand::RecordBindingType::INT_TYPE};
+  transaction->commands.push_back(std::move(read));
+
+  return transaction;
+}
+
+}  // namespace
+
+// The client remote is left unbound, so any transaction sent to the browser
+// instead of being run in this process fails the test
+class BatLedgerClientMojoBridgeTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+ protected:
+  void CreateBridge(const base::FilePath& database_path) {
+    bridge_ = std::make_unique<BatLedgerClientMojoBridge>(
+        mojo::PendingAssociatedRemote<mojom::BatLedgerClient>(),
+        database_path);
+  }
+
+  ledger::type::DBCommandResponsePtr RunDBTransaction(
+      ledger::type::DBTransactionPtr transaction) {
+    ledger::type::DBCommandResponsePtr response;
+    base::RunLoop run_loop;
+    bridge_->RunDBTransaction(
+        std::move(transaction),
+        [&response, &run_loop](ledger::type::DBCommandResponsePtr result) {
+          response = std::move(result);
+          run_loop.Quit();
+        });
+    run_loop.Run();
+
+    return response;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BatLedgerClientMojoBridge> bridge_;
+};
+
+TEST_F(BatLedgerClientMojoBridgeTest, RunTransactionInProcess) {
+  // Arrange
+  CreateBridge(temp_dir_.GetPath().AppendASCII("publisher_info_db"));
+
+  // Act
+  const ledger::type::DBCommandResponsePtr response =
+      RunDBTransaction(CreateTransaction());
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ledger::type::DBCommandResponse::Status::RESPONSE_OK,
+            response->status);
+  ASSERT_TRUE(response->result);
+  ASSERT_EQ(1u, response->result->get_records().size());
+  EXPECT_EQ(1,
+            response->result->get_records()[0]->fields[0]->get_int_value());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, CloseDatabaseBeforeReply) {
+  // Arrange
+  CreateBridge(temp_dir_.GetPath().AppendASCII("publisher_info_db"));
+
+  int transaction_count = 0;
+  bool deleted = false;
+  bridge_->SetDatabaseForTesting(
+      std::make_unique<FakeLedgerDatabase>(&transaction_count, &deleted));
+
+  // Act
+  ledger::type::DBCommandResponsePtr response;
+  bridge_->RunDBTransaction(
+      CreateTransaction(),
+      [&response](ledger::type::DBCommandResponsePtr result) {
+        response = std::move(result);
+      });
+
+  bool deleted_before_reply = false;
+  base::RunLoop run_loop;
+  bridge_->CloseDatabase(base::BindOnce(
+      [](bool* deleted, bool* deleted_before_reply, base::OnceClosure quit) {
+        *deleted_before_reply = *deleted;
+        std::move(quit).Run();
+      },
+      &deleted, &deleted_before_reply, run_loop.QuitClosure()));
+  run_loop.Run();
+
+  // Assert
+  EXPECT_TRUE(deleted_before_reply);
+  EXPECT_EQ(1, transaction_count);
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ledger::type::DBCommandResponse::Status::RESPONSE_OK,
+            response->status);
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, ReplyWithErrorAfterDatabaseIsClosed) {
+  // Arrange
+  CreateBridge(temp_dir_.GetPath().AppendASCII("publisher_info_db"));
+
+  base::RunLoop run_loop;
+  bridge_->CloseDatabase(run_loop.QuitClosure());
+  run_loop.Run();
+
+  // Act
+  const ledger::type::DBCommandResponsePtr response =
+      RunDBTransaction(CreateTransaction());
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ledger::type::DBCommandResponse::Status::RESPONSE_ERROR,
+            response->status);
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, ReplyWithErrorForNullDatabase) {
+  // Arrange
+  CreateBridge(temp_dir_.GetPath().AppendASCII("publisher_info_db"));
+  bridge_->SetDatabaseForTesting(nullptr);
+
+  // Act
+  const ledger::type::DBCommandResponsePtr response =
+      RunDBTransaction(CreateTransaction());
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ledger::type::DBCommandResponse::Status::RESPONSE_ERROR,
+            response->status);
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, ReplyWithErrorIfDatabaseFailsToOpen) {
+  // Arrange
+  CreateBridge(temp_dir_.GetPath());
+
+  // Act
+  const ledger::type::DBCommandResponsePtr response =
+      RunDBTransaction(CreateTransaction());
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ledger::type::DBCommandResponse::Status::INITIALIZATION_ERROR,
+            response->status);
+}
+
+}  // namespace bat_ledger
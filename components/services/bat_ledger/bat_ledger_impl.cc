@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/containers/flat_map.h"
 #include "brave/components/services/bat_ledger/bat_ledger_client_mojo_bridge.h"
 
@@ -22,9 +23,10 @@ using std::placeholders::_3;
 namespace bat_ledger {
 
 BatLedgerImpl::BatLedgerImpl(
-    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info)
+    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+    const base::FilePath& database_path)
   : bat_ledger_client_mojo_bridge_(
-      new BatLedgerClientMojoBridge(std::move(client_info))),
+      new BatLedgerClientMojoBridge(std::move(client_info), database_path)),
     ledger_(
       ledger::Ledger::CreateInstance(bat_ledger_client_mojo_bridge_.get())) {
 }
@@ -41,7 +43,10 @@ void BatLedgerImpl::OnInitialize(
 }
 void BatLedgerImpl::Initialize(
     const bool execute_create_script,
+    base::flat_map<std::string, base::Value> state,
     InitializeCallback callback) {
+  bat_ledger_client_mojo_bridge_->SetState(std::move(state));
+
   auto* holder = new CallbackHolder<InitializeCallback>(
       AsWeakPtr(), std::move(callback));
   ledger_->Initialize(
@@ -1093,9 +1098,20 @@ void BatLedgerImpl::OnShutdown(
   delete holder;
 }
 
+void BatLedgerImpl::OnLedgerShutdown(
+    ShutdownCallback callback,
+    const ledger::type::Result result) {
+  // The browser deletes the database once the ledger has shut down, so the
+  // database must be closed before replying
+  bat_ledger_client_mojo_bridge_->CloseDatabase(
+      base::BindOnce(std::move(callback), result));
+}
+
 void BatLedgerImpl::Shutdown(ShutdownCallback callback) {
   auto* holder = new CallbackHolder<ShutdownCallback>(
-      AsWeakPtr(), std::move(callback));
+      AsWeakPtr(),
+      base::BindOnce(&BatLedgerImpl::OnLedgerShutdown, AsWeakPtr(),
+          std::move(callback)));
 
   ledger_->Shutdown(
       std::bind(BatLedgerImpl::OnShutdown,
@@ -14,7 +14,9 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 
@@ -26,8 +28,9 @@ class BatLedgerImpl :
     public mojom::BatLedger,
     public base::SupportsWeakPtr<BatLedgerImpl> {
  public:
-  explicit BatLedgerImpl(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+  BatLedgerImpl(
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      const base::FilePath& database_path);
   ~BatLedgerImpl() override;
 
   BatLedgerImpl(const BatLedgerImpl&) = delete;
@@ -36,6 +39,7 @@ class BatLedgerImpl :
   // bat_ledger::mojom::BatLedger
   void Initialize(
     const bool execute_create_script,
+    base::flat_map<std::string, base::Value> state,
     InitializeCallback callback) override;
   void CreateWallet(CreateWalletCallback callback) override;
   void GetRewardsParameters(GetRewardsParametersCallback callback) override;
@@ -444,6 +448,10 @@ class BatLedgerImpl :
       CallbackHolder<ShutdownCallback>* holder,
       const ledger::type::Result result);
 
+  void OnLedgerShutdown(
+      ShutdownCallback callback,
+      const ledger::type::Result result);
+
   static void OnGetEventLogs(
       CallbackHolder<GetEventLogsCallback>* holder,
       ledger::type::EventLogs logs);
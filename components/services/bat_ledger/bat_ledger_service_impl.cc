@@ -26,12 +26,17 @@ BatLedgerServiceImpl::BatLedgerServiceImpl(
 
 BatLedgerServiceImpl::~BatLedgerServiceImpl() = default;
 
+void BatLedgerServiceImpl::SetDatabasePath(const base::FilePath& path) {
+  DCHECK(!initialized_);
+  database_path_ = path;
+}
+
 void BatLedgerServiceImpl::Create(
     mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
     mojo::PendingAssociatedReceiver<mojom::BatLedger> bat_ledger,
     CreateCallback callback) {
   associated_receivers_.Add(
-      std::make_unique<BatLedgerImpl>(std::move(client_info)),
+      std::make_unique<BatLedgerImpl>(std::move(client_info), database_path_),
       std::move(bat_ledger));
   initialized_ = true;
   std::move(callback).Run();
@@ -8,6 +8,7 @@
 
 #include <memory>
 
+#include "base/files/file_path.h"
 #include "bat/ledger/ledger.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
@@ -29,6 +30,8 @@ class BatLedgerServiceImpl : public mojom::BatLedgerService {
   BatLedgerServiceImpl& operator=(const BatLedgerServiceImpl&) = delete;
 
   // bat_ledger::mojom::BatLedgerService
+  void SetDatabasePath(const base::FilePath& path) override;
+
   void Create(
       mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
       mojo::PendingAssociatedReceiver<mojom::BatLedger> bat_ledger,
@@ -48,6 +51,7 @@ class BatLedgerServiceImpl : public mojom::BatLedgerService {
  private:
   mojo::Receiver<mojom::BatLedgerService> receiver_;
   bool initialized_;
+  base::FilePath database_path_;
   mojo::UniqueAssociatedReceiverSet<mojom::BatLedger> associated_receivers_;
 };
 
@@ -48,10 +48,7 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   const std::string& GetContentStylesheet();
 
  private:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<speedreader::SpeedReader>;
-
-  void OnLoadDATFileData(GetDATFileDataResult result);
+  void OnLoadDATFileData(std::unique_ptr<speedreader::SpeedReader> speedreader);
   void OnLoadStylesheet(std::string stylesheet);
 
   // Default backend is an Arc90 implementation.
@@ -30,6 +30,7 @@
 #include "net/url_request/url_request_context.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/proxy_lookup_client.mojom.h"
+#include "url/gurl.h"
 
 using content::BrowserContext;
 using content::BrowserThread;
@@ -41,6 +42,12 @@ namespace tor {
 
 namespace {
 
+// How long a pre-warmed connection is expected to stay idle in the socket pool
+// before it is closed, after which another signal for the same site should
+// pre-warm a new one
+constexpr base::TimeDelta kPreconnectInterval =
+    base::TimeDelta::FromSeconds(10);
+
 class NewTorCircuitTracker : public WebContentsObserver {
  public:
   explicit NewTorCircuitTracker(content::WebContents* web_contents)
@@ -191,20 +198,57 @@ void TorProfileServiceImpl::SetNewTorCircuit(WebContents* tab) {
 
   proxy_config_service_->SetNewTorCircuit(url);
 
+  // A connection pre-warmed for the site used the old circuit's credentials
+  const net::SchemefulSite url_site(url);
+  last_preconnect_times_.erase(url_site);
+
   // Force lookup to erase the old circuit and also get a callback
   // so we know when it is safe to reload the tab
+  auto proxy_lookup_client =
+      TorProxyLookupClient::CreateTorProxyLookupClient(std::move(callback));
+  const net::NetworkIsolationKey network_isolation_key(url_site, url_site);
+  GetStoragePartitionForURL(url)->GetNetworkContext()->LookUpProxyForURL(
+      url, network_isolation_key, std::move(proxy_lookup_client));
+}
+
+void TorProfileServiceImpl::PreconnectForURL(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Never pre-warm a connection before there is a Tor proxy to send it through
+  if (!url.SchemeIsHTTPOrHTTPS() || !IsTorConnected())
+    return;
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (auto iter = last_preconnect_times_.begin();
+       iter != last_preconnect_times_.end();) {
+    if (now - iter->second >= kPreconnectInterval) {
+      iter = last_preconnect_times_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  const net::SchemefulSite url_site(url);
+  if (!last_preconnect_times_.emplace(url_site, now).second)
+    return;
+
+  // Proxy resolution for the preconnect uses the same circuit isolation
+  // credentials as the navigation will, and the SOCKS5 socket pool is keyed by
+  // the proxy server including those credentials, so the navigation picks up
+  // the already authenticated socket if it has not expired
+  const net::NetworkIsolationKey network_isolation_key(url_site, url_site);
+  GetStoragePartitionForURL(url)->GetNetworkContext()->PreconnectSockets(
+      1, url.GetOrigin(), /*allow_credentials=*/true, network_isolation_key);
+}
+
+content::StoragePartition* TorProfileServiceImpl::GetStoragePartitionForURL(
+    const GURL& url) const {
   auto* storage_partition =
       BrowserContext::GetStoragePartitionForUrl(context_, url, false);
   if (!storage_partition) {
     storage_partition =
         content::BrowserContext::GetDefaultStoragePartition(context_);
   }
-  auto proxy_lookup_client =
-      TorProxyLookupClient::CreateTorProxyLookupClient(std::move(callback));
-  const net::SchemefulSite url_site(url);
-  const net::NetworkIsolationKey network_isolation_key(url_site, url_site);
-  storage_partition->GetNetworkContext()->LookUpProxyForURL(
-      url, network_isolation_key, std::move(proxy_lookup_client));
+  return storage_partition;
 }
 
 void TorProfileServiceImpl::KillTor() {
@@ -6,19 +6,23 @@
 #ifndef BRAVE_COMPONENTS_TOR_TOR_PROFILE_SERVICE_IMPL_H_
 #define BRAVE_COMPONENTS_TOR_TOR_PROFILE_SERVICE_IMPL_H_
 
+#include <map>
 #include <memory>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
 #include "base/optional.h"
+#include "base/time/time.h"
 #include "brave/components/tor/brave_tor_client_updater.h"
 #include "brave/components/tor/tor_launcher_factory.h"
 #include "brave/components/tor/tor_launcher_observer.h"
 #include "brave/components/tor/tor_profile_service.h"
+#include "net/base/schemeful_site.h"
 #include "net/proxy_resolution/proxy_info.h"
 
 namespace content {
 class BrowserContext;
+class StoragePartition;
 }  // namespace content
 
 namespace net {
@@ -43,6 +47,7 @@ class TorProfileServiceImpl : public TorProfileService,
   void RegisterTorClientUpdater() override;
   void UnregisterTorClientUpdater() override;
   void SetNewTorCircuit(content::WebContents* web_contents) override;
+  void PreconnectForURL(const GURL& url) override;
   std::unique_ptr<net::ProxyConfigService> CreateProxyConfigService() override;
   bool IsTorConnected() override;
   void KillTor() override;
@@ -54,6 +59,8 @@ class TorProfileServiceImpl : public TorProfileService,
  private:
   void LaunchTor();
 
+  content::StoragePartition* GetStoragePartitionForURL(const GURL& url) const;
+
   base::FilePath GetTorExecutablePath() const;
   base::FilePath GetTorDataPath() const;
   base::FilePath GetTorWatchPath() const;
@@ -65,6 +72,10 @@ class TorProfileServiceImpl : public TorProfileService,
   BraveTorClientUpdater* tor_client_updater_ = nullptr;
   TorLauncherFactory* tor_launcher_factory_;  // Singleton
   net::ProxyConfigServiceTor* proxy_config_service_;  // NOT OWNED
+  // When a connection was last pre-warmed for each site, so that repeated
+  // omnibox and link hover signals for a site are not sent to the network
+  // service over and over
+  std::map<net::SchemefulSite, base::TimeTicks> last_preconnect_times_;
   base::WeakPtrFactory<TorProfileServiceImpl> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(TorProfileServiceImpl);
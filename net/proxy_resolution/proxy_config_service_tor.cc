@@ -8,7 +8,9 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -18,30 +20,44 @@
 #include "base/time/time.h"
 #include "base/values.h"
 #include "crypto/random.h"
-#include "net/base/network_isolation_key.h"
 #include "net/base/schemeful_site.h"
 #include "net/proxy_resolution/proxy_config_with_annotation.h"
+#include "net/proxy_resolution/proxy_info.h"
 #include "net/proxy_resolution/proxy_resolution_service.h"
 
 namespace net {
 
-// Used to cache <username, password> of proxies
+// Used to cache <username, password> of proxies for a proxy resolution
+// service
 class TorProxyMap {
  public:
-  TorProxyMap();
+  explicit TorProxyMap(ProxyResolutionService* service);
   ~TorProxyMap();
-  std::string Get(const std::string& key);
+  const std::string& Get(const std::string& key);
   void Erase(const std::string& key);
   void MaybeExpire(const std::string& key, const base::Time& timestamp);
   size_t size() const;
 
  private:
+  using QueueEntry = std::pair<base::Time, std::string>;
+
   // Generate a new base 64-encoded 128 bit random tag
   static std::string GenerateNewPassword();
   // Clear expired entries in the queue from the map.
   void ClearExpiredEntries();
-  std::map<std::string, std::pair<std::string, base::Time>> map_;
-  std::priority_queue<std::pair<base::Time, std::string>> queue_;
+  // Schedule |OnExpiryTimer| for when the oldest entry expires.
+  void StartExpiryTimer();
+  // Clear expired entries and delete this map once it is empty, so maps of
+  // services which are no longer used do not outlive their entries.
+  void OnExpiryTimer();
+
+  ProxyResolutionService* service_;
+  std::unordered_map<std::string, std::pair<std::string, base::Time>> map_;
+  // Oldest entry first
+  std::priority_queue<QueueEntry,
+                      std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      queue_;
   base::OneShotTimer timer_;
   DISALLOW_COPY_AND_ASSIGN(TorProxyMap);
 };
@@ -68,30 +84,22 @@ constexpr NetworkTrafficAnnotationTag kTorProxyTrafficAnnotation =
         policy_exception_justification: "Not implemented."
       })");
 
-static base::NoDestructor<std::map<
-    ProxyResolutionService*, TorProxyMap>> tor_proxy_map_;
+static base::NoDestructor<std::unordered_map<ProxyResolutionService*,
+                                             std::unique_ptr<TorProxyMap>>>
+    tor_proxy_map_;
 
 TorProxyMap* GetTorProxyMap(
     ProxyResolutionService* service) {
-  return &(tor_proxy_map_.get()->operator[](service));
+  std::unique_ptr<TorProxyMap>& map = tor_proxy_map_.get()->operator[](service);
+  if (!map)
+    map = std::make_unique<TorProxyMap>(service);
+  return map.get();
 }
 
+// Empty maps are deleted by their expiry timer, so this is only a comparison
+// and is cheap enough for resolutions in profiles which do not use Tor
 bool IsTorProxyConfig(const ProxyConfigWithAnnotation& config) {
-  auto tag = config.traffic_annotation();
-  // iterate through tor_proxy_map_ and remove any entries with
-  // empty TorProxyMap (all entries have expired)
-  // we do this here because the other methods are only called when
-  // IsTorProxy is true so the last entry will never be deleted
-  for (auto it = tor_proxy_map_.get()->cbegin();
-       it != tor_proxy_map_.get()->cend(); ) {
-    if (it->second.size() == 0) {
-      tor_proxy_map_->erase(it++);
-    } else {
-      ++it;
-    }
-  }
-
-  return tag.unique_id_hash_code ==
+  return config.traffic_annotation().unique_id_hash_code ==
          kTorProxyTrafficAnnotation.unique_id_hash_code;
 }
 
@@ -137,14 +145,10 @@ std::string ProxyConfigServiceTor::CircuitIsolationKey(const GURL& url) {
   //
   // In particular, we need not isolate by the scheme,
   // username/password, port, path, or query part of the URL.
+  //
+  // This is the top frame site of a network isolation key for |url|.
   const net::SchemefulSite url_site(url);
-  const net::NetworkIsolationKey network_isolation_key(url_site, url_site);
-
-  const base::Optional<net::SchemefulSite>& schemeful_site =
-      network_isolation_key.GetTopFrameSite();
-  DCHECK(schemeful_site.has_value());
-  std::string host = GURL(schemeful_site->Serialize()).host();
-  return host;
+  return GURL(url_site.Serialize()).host();
 }
 
 void ProxyConfigServiceTor::SetNewTorCircuit(const GURL& url) {
@@ -177,33 +181,28 @@ void ProxyConfigServiceTor::SetProxyAuthorization(
   // Adding username & password to global sock://127.0.0.1:[port] config
   // without actually modifying it when resolving proxy for each url.
   const std::string username = CircuitIsolationKey(url);
-  const std::string& proxy_uri =
-      config.value().proxy_rules().single_proxies.Get().ToURI();
+  if (username.empty())
+    return;
+
   HostPortPair host_port_pair =
       config.value().proxy_rules().single_proxies.Get().host_port_pair();
-
-  if (!username.empty()) {
-    auto* map = GetTorProxyMap(service);
-    if (host_port_pair.username() == username) {
-      // password is a int64_t -> std::to_string in milliseconds
-      int64_t time = strtoll(host_port_pair.password().c_str(), nullptr, 10);
-      map->MaybeExpire(host_port_pair.username(),
-          base::Time::FromDeltaSinceWindowsEpoch(
-              base::TimeDelta::FromMicroseconds(time)));
-    }
-    host_port_pair.set_username(username);
-    host_port_pair.set_password(map->Get(username));
-
-    ProxyConfigServiceTor tor_proxy_config_service(proxy_uri);
-    tor_proxy_config_service.proxy_server_ =
-        ProxyServer(ProxyServer::SCHEME_SOCKS5, host_port_pair);
-
-    ProxyConfigWithAnnotation fetched_config;
-    tor_proxy_config_service.GetLatestProxyConfig(&fetched_config);
-    fetched_config.value().proxy_rules().Apply(url, result);
-    result->set_traffic_annotation(MutableNetworkTrafficAnnotationTag(
-        fetched_config.traffic_annotation()));
+  auto* map = GetTorProxyMap(service);
+  if (host_port_pair.username() == username) {
+    // password is a int64_t -> std::to_string in microseconds
+    int64_t time = strtoll(host_port_pair.password().c_str(), nullptr, 10);
+    map->MaybeExpire(host_port_pair.username(),
+        base::Time::FromDeltaSinceWindowsEpoch(
+            base::TimeDelta::FromMicroseconds(time)));
   }
+  host_port_pair.set_username(username);
+  host_port_pair.set_password(map->Get(username));
+
+  // Tor configs are a single SOCKS5 proxy without bypass rules, see
+  // |GetLatestProxyConfig|, so applying them always uses the proxy
+  result->UseProxyServer(
+      ProxyServer(ProxyServer::SCHEME_SOCKS5, host_port_pair));
+  result->set_traffic_annotation(
+      MutableNetworkTrafficAnnotationTag(kTorProxyTrafficAnnotation));
 }
 
 void ProxyConfigServiceTor::AddObserver(Observer* observer) {
@@ -229,7 +228,8 @@ ProxyConfigServiceTor::GetLatestProxyConfig(
   return CONFIG_VALID;
 }
 
-TorProxyMap::TorProxyMap() = default;
+TorProxyMap::TorProxyMap(ProxyResolutionService* service)
+    : service_(service) {}
 TorProxyMap::~TorProxyMap() {
   timer_.Stop();
 }
@@ -241,7 +241,7 @@ std::string TorProxyMap::GenerateNewPassword() {
   return base::HexEncode(password.data(), password.size());
 }
 
-std::string TorProxyMap::Get(
+const std::string& TorProxyMap::Get(
     const std::string& username) {
   // Clear any expired entries, in case this one has expired.
   ClearExpiredEntries();
@@ -253,19 +253,17 @@ std::string TorProxyMap::Get(
 
   // No entry yet.  Check our watch and create one.
   const base::Time now = base::Time::Now();
-  const std::string password = GenerateNewPassword();
-  map_.emplace(username, std::make_pair(password, now));
+  auto inserted =
+      map_.emplace(username, std::make_pair(GenerateNewPassword(), now));
   queue_.emplace(now, username);
 
-  // Reschedule the timer for ten minutes from now so that this entry
-  // won't last more than about ten minutes even if the user stops
-  // using Tor for a while.
-  // TODO(bridiver) - the timer should be in the ProxyConfigServiceTor class
-  timer_.Stop();
-  timer_.Start(FROM_HERE, kTenMins, this,
-               &TorProxyMap::ClearExpiredEntries);
+  // Make sure this entry won't last more than about ten minutes even
+  // if the user stops using Tor for a while.  A running timer is
+  // already due for an older entry.
+  if (!timer_.IsRunning())
+    StartExpiryTimer();
 
-  return password;
+  return inserted.first->second.first;
 }
 
 size_t TorProxyMap::size() const {
@@ -294,10 +292,10 @@ void TorProxyMap::MaybeExpire(
 void TorProxyMap::ClearExpiredEntries() {
   const base::Time cutoff = base::Time::Now() - kTenMins;
   for (; !queue_.empty(); queue_.pop()) {
-    // Check the timestamp.  If it's not older than the cutoff, stop.
-    const std::pair<base::Time, std::string>* entry = &queue_.top();
+    // Check the timestamp.  If it's newer than the cutoff, stop.
+    const QueueEntry* entry = &queue_.top();
     const base::Time timestamp = entry->first;
-    if (!(timestamp < cutoff))
+    if (timestamp > cutoff)
       break;
 
     // Remove the corresponding entry in the map if there is one and
@@ -318,4 +316,26 @@ void TorProxyMap::ClearExpiredEntries() {
   }
 }
 
+void TorProxyMap::StartExpiryTimer() {
+  if (queue_.empty())
+    return;
+
+  const base::TimeDelta delay =
+      std::max(queue_.top().first + kTenMins - base::Time::Now(),
+               base::TimeDelta());
+  timer_.Start(FROM_HERE, delay, this, &TorProxyMap::OnExpiryTimer);
+}
+
+void TorProxyMap::OnExpiryTimer() {
+  ClearExpiredEntries();
+
+  if (map_.empty()) {
+    // Deletes this map, which is safe from within its own one shot timer.
+    tor_proxy_map_->erase(service_);
+    return;
+  }
+
+  StartExpiryTimer();
+}
+
 }  // namespace net
@@ -5,10 +5,13 @@
 
 #include "brave/net/proxy_resolution/proxy_config_service_tor.h"
 
+#include <set>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "net/base/proxy_server.h"
 #include "net/proxy_resolution/configured_proxy_resolution_service.h"
@@ -29,6 +32,43 @@ class ProxyConfigServiceTorTest : public TestWithTaskEnvironment {
   DISALLOW_COPY_AND_ASSIGN(ProxyConfigServiceTorTest);
 };
 
+class ProxyConfigServiceTorMockTimeTest : public TestWithTaskEnvironment {
+ public:
+  ProxyConfigServiceTorMockTimeTest()
+      : TestWithTaskEnvironment(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+  ~ProxyConfigServiceTorMockTimeTest() override {}
+
+ protected:
+  // Services are only used as keys, so they are leaked like in
+  // |SetProxyAuthorization| to keep keys unique across tests
+  ProxyResolutionService* CreateService() {
+    return new ConfiguredProxyResolutionService(
+        ConfiguredProxyResolutionService::CreateSystemProxyConfigService(
+            base::ThreadTaskRunnerHandle::Get()),
+        std::make_unique<MockAsyncProxyResolverFactory>(false), nullptr,
+        /*quick_check_enabled=*/true);
+  }
+
+  ProxyConfigWithAnnotation GetTorConfig() {
+    ProxyConfigServiceTor proxy_config_service("socks5://127.0.0.1:5566");
+    ProxyConfigWithAnnotation config;
+    proxy_config_service.GetLatestProxyConfig(&config);
+    return config;
+  }
+
+  std::string GetPassword(const ProxyConfigWithAnnotation& config,
+                          const GURL& url,
+                          ProxyResolutionService* service) {
+    ProxyInfo info;
+    ProxyConfigServiceTor::SetProxyAuthorization(config, url, service, &info);
+    return info.proxy_server().host_port_pair().password();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ProxyConfigServiceTorMockTimeTest);
+};
+
 TEST_F(ProxyConfigServiceTorTest, CircuitIsolationKey) {
   const struct {
     GURL url;
@@ -211,4 +251,70 @@ TEST_F(ProxyConfigServiceTorTest, SetProxyAuthorization) {
   EXPECT_EQ(host_port_pair.port(), 5566);
 }
 
+TEST_F(ProxyConfigServiceTorMockTimeTest, IgnoreNonTorConfig) {
+  ProxyInfo info;
+  ProxyConfigServiceTor::SetProxyAuthorization(
+      ProxyConfigWithAnnotation::CreateDirect(),
+      GURL("https://check.torproject.org/"), CreateService(), &info);
+  EXPECT_TRUE(info.is_empty());
+}
+
+TEST_F(ProxyConfigServiceTorMockTimeTest, ExpireCircuits) {
+  const GURL site_url("https://check.torproject.org/");
+  const GURL site_url2("https://brave.com/");
+  ProxyResolutionService* service = CreateService();
+  const ProxyConfigWithAnnotation config = GetTorConfig();
+
+  const std::string password = GetPassword(config, site_url, service);
+  FastForwardBy(base::TimeDelta::FromMinutes(5));
+  const std::string password2 = GetPassword(config, site_url2, service);
+
+  // Circuits last ten minutes from their first use
+  FastForwardBy(base::TimeDelta::FromMinutes(5) -
+                base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(password, GetPassword(config, site_url, service));
+  EXPECT_EQ(password2, GetPassword(config, site_url2, service));
+
+  FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_NE(password, GetPassword(config, site_url, service));
+  EXPECT_EQ(password2, GetPassword(config, site_url2, service));
+
+  // Expiry does not depend on resolving again
+  FastForwardBy(base::TimeDelta::FromMinutes(10));
+  const std::string new_password = GetPassword(config, site_url2, service);
+  EXPECT_NE(password2, new_password);
+}
+
+TEST_F(ProxyConfigServiceTorMockTimeTest, ResolveManySites) {
+  const int kSites = 1000;
+  const int kResolutions = 100000;
+  ProxyResolutionService* service = CreateService();
+  const ProxyConfigWithAnnotation config = GetTorConfig();
+
+  std::vector<std::string> passwords(kSites);
+  for (int i = 0; i < kResolutions; i++) {
+    const int site = i % kSites;
+    const GURL url("https://www.site" + base::NumberToString(site) +
+                   ".com/" + base::NumberToString(i));
+
+    ProxyInfo info;
+    ProxyConfigServiceTor::SetProxyAuthorization(config, url, service, &info);
+    const HostPortPair& host_port_pair = info.proxy_server().host_port_pair();
+    ASSERT_EQ(host_port_pair.username(),
+              "site" + base::NumberToString(site) + ".com");
+    ASSERT_EQ(host_port_pair.host(), "127.0.0.1");
+    ASSERT_EQ(host_port_pair.port(), 5566);
+
+    if (i < kSites) {
+      passwords[site] = host_port_pair.password();
+    } else {
+      ASSERT_EQ(passwords[site], host_port_pair.password());
+    }
+  }
+
+  // Every site has its own circuit
+  EXPECT_EQ(std::set<std::string>(passwords.begin(), passwords.end()).size(),
+            static_cast<size_t>(kSites));
+}
+
 }  // namespace net
@@ -0,0 +1,244 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/run_loop.h"
+#include "base/stl_util.h"
+#include "brave/net/proxy_resolution/proxy_config_service_tor.h"
+#include "net/base/load_timing_info.h"
+#include "net/base/load_timing_info_test_util.h"
+#include "net/base/network_isolation_key.h"
+#include "net/base/proxy_server.h"
+#include "net/base/test_completion_callback.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_network_transaction.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_response_info.h"
+#include "net/http/http_stream_factory.h"
+#include "net/log/net_log_with_source.h"
+#include "net/proxy_resolution/configured_proxy_resolution_service.h"
+#include "net/proxy_resolution/mock_proxy_resolver.h"
+#include "net/proxy_resolution/proxy_info.h"
+#include "net/proxy_resolution/proxy_resolution_request.h"
+#include "net/socket/client_socket_pool.h"
+#include "net/socket/socket_test_util.h"
+#include "net/spdy/spdy_test_util_common.h"
+#include "net/test/gtest_util.h"
+#include "net/test/test_with_task_environment.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using net::test::IsOk;
+
+namespace net {
+
+namespace {
+
+const char kSOCKS5GreetingResponse[] = {0x05, 0x02};
+const char kSOCKS5AuthResponse[] = {0x01, 0x00};
+const char kSOCKS5ConnectResponse[] = {0x05, 0x00, 0x00, 0x01, 127,
+                                       0,    0,    1,    0x00, 0x50};
+
+const char kHttpResponse[] = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+
+// A SOCKS5 proxy connection which expects the client to authenticate with
+// |proxy_server|'s circuit isolation credentials and connect to |url|'s host on
+// port 80, and then serves one HTTP response
+class FakeSOCKS5Connection {
+ public:
+  FakeSOCKS5Connection(const ProxyServer& proxy_server, const GURL& url) {
+    const HostPortPair& host_port_pair = proxy_server.host_port_pair();
+    const std::string& username = host_port_pair.username();
+    const std::string& password = host_port_pair.password();
+
+    greeting_ = {0x05, 0x01, 0x02};
+
+    auth_.push_back(0x01);
+    auth_.push_back(static_cast<char>(username.size()));
+    auth_ += username;
+    auth_.push_back(static_cast<char>(password.size()));
+    auth_ += password;
+
+    connect_ = {0x05, 0x01, 0x00, 0x03};
+    connect_.push_back(static_cast<char>(url.host().size()));
+    connect_ += url.host();
+    connect_.push_back(0x00);
+    connect_.push_back(0x50);
+
+    http_request_ = "GET / HTTP/1.1\r\nHost: " + url.host() +
+                    "\r\nConnection: keep-alive\r\n\r\n";
+
+    writes_ = {MockWrite(ASYNC, greeting_.data(), greeting_.size()),
+               MockWrite(ASYNC, auth_.data(), auth_.size()),
+               MockWrite(ASYNC, connect_.data(), connect_.size()),
+               MockWrite(ASYNC, http_request_.data(), http_request_.size())};
+
+    reads_ = {MockRead(ASYNC, kSOCKS5GreetingResponse,
+                       base::size(kSOCKS5GreetingResponse)),
+              MockRead(ASYNC, kSOCKS5AuthResponse,
+                       base::size(kSOCKS5AuthResponse)),
+              MockRead(ASYNC, kSOCKS5ConnectResponse,
+                       base::size(kSOCKS5ConnectResponse)),
+              MockRead(ASYNC, kHttpResponse), MockRead(SYNCHRONOUS, OK)};
+
+    data_ = std::make_unique<StaticSocketDataProvider>(reads_, writes_);
+  }
+
+  StaticSocketDataProvider* data() { return data_.get(); }
+
+ private:
+  std::string greeting_;
+  std::string auth_;
+  std::string connect_;
+  std::string http_request_;
+  std::vector<MockWrite> writes_;
+  std::vector<MockRead> reads_;
+  std::unique_ptr<StaticSocketDataProvider> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeSOCKS5Connection);
+};
+
+}  // namespace
+
+class TorPreconnectTest : public TestWithTaskEnvironment {
+ public:
+  TorPreconnectTest()
+      : TestWithTaskEnvironment(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+  ~TorPreconnectTest() override {}
+
+  void SetUp() override {
+    auto proxy_resolution_service =
+        std::make_unique<ConfiguredProxyResolutionService>(
+            std::make_unique<ProxyConfigServiceTor>("socks5://127.0.0.1:5566"),
+            std::make_unique<MockAsyncProxyResolverFactory>(false), nullptr,
+            /*quick_check_enabled=*/true);
+    proxy_resolution_service_ = proxy_resolution_service.get();
+
+    session_deps_ = std::make_unique<SpdySessionDependencies>(
+        std::move(proxy_resolution_service));
+  }
+
+ protected:
+  void CreateSession() {
+    session_ = SpdySessionDependencies::SpdyCreateSession(session_deps_.get());
+  }
+
+  // Returns the Tor proxy for |url| including its circuit isolation
+  // credentials, which are the same ones a request for |url| will use
+  ProxyServer ResolveProxy(const GURL& url) {
+    ProxyInfo info;
+    TestCompletionCallback callback;
+    std::unique_ptr<ProxyResolutionRequest> request;
+    const int rv = proxy_resolution_service_->ResolveProxy(
+        url, std::string(), NetworkIsolationKey(), &info, callback.callback(),
+        &request, NetLogWithSource());
+    EXPECT_THAT(rv, IsOk());
+    return info.proxy_server();
+  }
+
+  HttpRequestInfo CreateRequestInfo(const GURL& url) {
+    HttpRequestInfo request_info;
+    request_info.method = "GET";
+    request_info.url = url;
+    request_info.traffic_annotation =
+        MutableNetworkTrafficAnnotationTag(TRAFFIC_ANNOTATION_FOR_TESTS);
+    return request_info;
+  }
+
+  void Preconnect(const GURL& url) {
+    HttpRequestInfo request_info = CreateRequestInfo(url);
+    session_->http_stream_factory()->PreconnectStreams(1, request_info);
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // Navigates to |url| and returns its load timing
+  LoadTimingInfo Navigate(const GURL& url) {
+    HttpRequestInfo request_info = CreateRequestInfo(url);
+    HttpNetworkTransaction transaction(DEFAULT_PRIORITY, session_.get());
+    TestCompletionCallback callback;
+    const int rv = transaction.Start(&request_info, callback.callback(),
+                                     NetLogWithSource());
+    EXPECT_THAT(callback.GetResult(rv), IsOk());
+    EXPECT_EQ(200, transaction.GetResponseInfo()->headers->response_code());
+
+    LoadTimingInfo load_timing_info;
+    EXPECT_TRUE(transaction.GetLoadTimingInfo(&load_timing_info));
+    return load_timing_info;
+  }
+
+  int GetIdleSocketCount(const ProxyServer& proxy_server) {
+    return session_
+        ->GetSocketPool(HttpNetworkSession::NORMAL_SOCKET_POOL, proxy_server)
+        ->IdleSocketCount();
+  }
+
+  std::unique_ptr<SpdySessionDependencies> session_deps_;
+  std::unique_ptr<HttpNetworkSession> session_;
+  ProxyResolutionService* proxy_resolution_service_ = nullptr;  // NOT OWNED
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TorPreconnectTest);
+};
+
+TEST_F(TorPreconnectTest, NavigationUsesPreconnectedSocket) {
+  const GURL url("http://www.example.org/");
+  const ProxyServer proxy_server = ResolveProxy(url);
+  ASSERT_FALSE(proxy_server.host_port_pair().username().empty());
+
+  FakeSOCKS5Connection connection(proxy_server, url);
+  session_deps_->socket_factory->AddSocketDataProvider(connection.data());
+  CreateSession();
+
+  // The SOCKS5 handshake, including authenticating with the circuit isolation
+  // credentials, completes before the navigation starts
+  Preconnect(url);
+  EXPECT_EQ(1, GetIdleSocketCount(proxy_server));
+
+  FastForwardBy(base::TimeDelta::FromSeconds(1));
+
+  const LoadTimingInfo load_timing_info = Navigate(url);
+  EXPECT_TRUE(load_timing_info.socket_reused);
+  ExpectConnectTimingHasNoTimes(load_timing_info.connect_timing);
+
+  EXPECT_TRUE(connection.data()->AllReadDataConsumed());
+  EXPECT_TRUE(connection.data()->AllWriteDataConsumed());
+}
+
+TEST_F(TorPreconnectTest, NavigationToOtherSiteDoesNotUsePreconnectedSocket) {
+  const GURL preconnect_url("http://www.example.org/");
+  const ProxyServer preconnect_proxy_server = ResolveProxy(preconnect_url);
+  const GURL url("http://www.example.com/");
+  const ProxyServer proxy_server = ResolveProxy(url);
+  ASSERT_NE(preconnect_proxy_server.host_port_pair().username(),
+            proxy_server.host_port_pair().username());
+
+  FakeSOCKS5Connection preconnect_connection(preconnect_proxy_server,
+                                             preconnect_url);
+  session_deps_->socket_factory->AddSocketDataProvider(
+      preconnect_connection.data());
+  FakeSOCKS5Connection connection(proxy_server, url);
+  session_deps_->socket_factory->AddSocketDataProvider(connection.data());
+  CreateSession();
+
+  Preconnect(preconnect_url);
+
+  // A different site uses a different circuit, so must not share the socket
+  // which was authenticated for the preconnected site
+  const LoadTimingInfo load_timing_info = Navigate(url);
+  EXPECT_FALSE(load_timing_info.socket_reused);
+  EXPECT_EQ(1, GetIdleSocketCount(preconnect_proxy_server));
+
+  EXPECT_TRUE(connection.data()->AllWriteDataConsumed());
+}
+
+}  // namespace net